@@ -28,26 +28,36 @@ static rpc::client& GetRpclibClient()
 #define ANKERL_NANOBENCH_IMPLEMENT
 #include <nanobench.h>
 
+#include <iostream>
+#include <numeric>
+
 namespace nanobench = ankerl::nanobench;
 
 #if defined(RPC_HPP_ENABLE_BITSERY)
-constexpr uint64_t bitsery_adapter::config::max_func_name_size = 30;
-constexpr uint64_t bitsery_adapter::config::max_string_size = 2'048;
-constexpr uint64_t bitsery_adapter::config::max_container_size = 1'000;
+using rpc_hpp::adapters::bitsery_adapter;
+
+// Each encoding has its own server, with the default limits
+using bitsery_exact_adapter = rpc_hpp::adapters::basic_bitsery_adapter<
+    rpc_hpp::adapters::bitsery_config<rpc_hpp::adapters::bitsery_encoding::exact>>;
+using bitsery_wide_adapter = rpc_hpp::adapters::basic_bitsery_adapter<
+    rpc_hpp::adapters::bitsery_config<rpc_hpp::adapters::bitsery_encoding::wide>>;
+using bitsery_compact_adapter = rpc_hpp::adapters::basic_bitsery_adapter<
+    rpc_hpp::adapters::bitsery_config<rpc_hpp::adapters::bitsery_encoding::compact>>;
 #endif
 
-template<typename T, typename... Args>
-void bench_rpc(
-    nanobench::Bench& bench, const T& expected, const std::string& func_name, Args&&... args)
+#if defined(RPC_HPP_ENABLE_BITSERY)
+// Each bitsery encoding is served on its own port, so all of them are measured in one run
+template<typename Serial, typename T, typename... Args>
+void bench_bitsery(nanobench::Bench& bench, const std::string& encoding, const T& expected,
+    const std::string& func_name, const Args&... args)
 {
     T test_val{};
 
-    bench.run("rpc.hpp (asio::tcp, njson)",
+    bench.run("rpc.hpp (asio::tcp, bitsery " + encoding + ")",
         [&]
         {
             nanobench::doNotOptimizeAway(
-                test_val = GetClient<njson_adapter>().template call_func<T>(
-                    func_name, std::forward<Args>(args)...));
+                test_val = GetClient<Serial>().template call_func<T>(func_name, args...));
         });
 
     if constexpr (std::is_floating_point_v<T>)
@@ -58,13 +68,20 @@ void bench_rpc(
     {
         REQUIRE(test_val == expected);
     }
+}
+#endif
 
-#if defined(RPC_HPP_ENABLE_RAPIDJSON)
-    bench.run("rpc.hpp (asio::tcp, rapidjson)",
+template<typename T, typename... Args>
+void bench_rpc(
+    nanobench::Bench& bench, const T& expected, const std::string& func_name, Args&&... args)
+{
+    T test_val{};
+
+    bench.run("rpc.hpp (asio::tcp, njson)",
         [&]
         {
             nanobench::doNotOptimizeAway(
-                test_val = GetClient<rapidjson_adapter>().template call_func<T>(
+                test_val = GetClient<njson_adapter>().template call_func<T>(
                     func_name, std::forward<Args>(args)...));
         });
 
@@ -76,14 +93,13 @@ void bench_rpc(
     {
         REQUIRE(test_val == expected);
     }
-#endif
 
-#if defined(RPC_HPP_ENABLE_BOOST_JSON)
-    bench.run("rpc.hpp (asio::tcp, Boost.JSON)",
+#if defined(RPC_HPP_ENABLE_RAPIDJSON)
+    bench.run("rpc.hpp (asio::tcp, rapidjson)",
         [&]
         {
             nanobench::doNotOptimizeAway(
-                test_val = GetClient<boost_json_adapter>().template call_func<T>(
+                test_val = GetClient<rapidjson_adapter>().template call_func<T>(
                     func_name, std::forward<Args>(args)...));
         });
 
@@ -97,12 +113,12 @@ void bench_rpc(
     }
 #endif
 
-#if defined(RPC_HPP_ENABLE_BITSERY)
-    bench.run("rpc.hpp (asio::tcp, bitsery)",
+#if defined(RPC_HPP_ENABLE_BOOST_JSON)
+    bench.run("rpc.hpp (asio::tcp, Boost.JSON)",
         [&]
         {
             nanobench::doNotOptimizeAway(
-                test_val = GetClient<bitsery_adapter>().template call_func<T>(
+                test_val = GetClient<boost_json_adapter>().template call_func<T>(
                     func_name, std::forward<Args>(args)...));
         });
 
@@ -116,6 +132,12 @@ void bench_rpc(
     }
 #endif
 
+#if defined(RPC_HPP_ENABLE_BITSERY)
+    bench_bitsery<bitsery_exact_adapter>(bench, "exact", expected, func_name, args...);
+    bench_bitsery<bitsery_wide_adapter>(bench, "wide", expected, func_name, args...);
+    bench_bitsery<bitsery_compact_adapter>(bench, "compact", expected, func_name, args...);
+#endif
+
 #if defined(RPC_HPP_BENCH_RPCLIB)
     bench.run("rpclib",
         [&]
@@ -137,6 +159,45 @@ void bench_rpc(
 #endif
 }
 
+// Prints the size of the request, and of the response the server sends back, for one call
+template<typename Serial, typename R, typename... Args>
+void print_message_size(
+    const std::string& adapter_name, const std::string& func_name, R result, const Args&... args)
+{
+    const std::tuple<const Args&...> call_args{ args... };
+    const auto request = Serial::to_bytes(Serial::template serialize_request<R>(
+        rpc_hpp::detail::request_view<Args...>{ 0, func_name, call_args }));
+
+    // By-value arguments are not sent back
+    rpc_hpp::detail::packed_func<R, Args...> pack{ func_name, std::move(result), { args... } };
+    pack.set_arg_mask(0);
+    const auto response = Serial::to_bytes(Serial::serialize_response(pack));
+
+    std::cout << "| " << adapter_name << " | " << func_name << " | " << request.size() << " | "
+              << response.size() << " |\n";
+}
+
+template<typename R, typename... Args>
+void print_message_sizes(const std::string& func_name, const R& result, const Args&... args)
+{
+    print_message_size<njson_adapter>("njson", func_name, result, args...);
+
+#if defined(RPC_HPP_ENABLE_RAPIDJSON)
+    print_message_size<rapidjson_adapter>("rapidjson", func_name, result, args...);
+#endif
+
+#if defined(RPC_HPP_ENABLE_BOOST_JSON)
+    print_message_size<boost_json_adapter>("Boost.JSON", func_name, result, args...);
+#endif
+
+#if defined(RPC_HPP_ENABLE_BITSERY)
+    print_message_size<bitsery_exact_adapter>("bitsery (exact)", func_name, result, args...);
+    print_message_size<bitsery_wide_adapter>("bitsery (wide)", func_name, result, args...);
+    print_message_size<bitsery_compact_adapter>(
+        "bitsery (compact)", func_name, result, args...);
+#endif
+}
+
 #if defined(RPC_HPP_BENCH_GRPC)
 template<typename T, typename F, typename... Args>
 void bench_grpc(nanobench::Bench& bench, const T& expected, F member_func, Args&&... args)
@@ -221,6 +282,21 @@ TEST_CASE("With Container")
 #endif
 }
 
+TEST_CASE("With Container (large)")
+{
+    static constexpr double expected = 499.5;
+    std::vector<double> input(1'000);
+    std::iota(input.begin(), input.end(), 0.0);
+
+    nanobench::Bench b;
+    b.title("With Container (large)").warmup(1).relative(true).minEpochIterations(500);
+    bench_rpc<double>(b, expected, "AverageContainer<double>", input);
+
+#if defined(RPC_HPP_BENCH_GRPC)
+    bench_grpc(b, expected, &gRPC_Client::AverageContainer_double, input);
+#endif
+}
+
 TEST_CASE("Sequential")
 {
     static constexpr uint64_t min_num = 5;
@@ -245,6 +321,86 @@ TEST_CASE("Sequential")
                 "AverageContainer<uint64_t>", vec));
         });
 
+    b.run("rpc.hpp (asio::tcp, njson, pipelined)",
+        [&]
+        {
+            auto& client = GetClient<njson_adapter>();
+            auto vec = client.template call_func<std::vector<uint64_t>>(
+                "GenRandInts", min_num, max_num, num_rands);
+
+            std::vector<rpc_hpp::pending_call<njson_adapter, uint64_t, uint64_t&>> calls;
+            calls.reserve(vec.size());
+
+            for (auto& val : vec)
+            {
+                calls.push_back(client.template call_func_pipelined<uint64_t>("Fibonacci", val));
+            }
+
+            for (size_t i = 0; i < vec.size(); ++i)
+            {
+                vec[i] = calls[i].get();
+            }
+
+            nanobench::doNotOptimizeAway(
+                client.template call_func<double>("AverageContainer<uint64_t>", vec));
+        });
+
+    b.run("rpc.hpp (asio::tcp, njson, batched)",
+        [&]
+        {
+            auto& client = GetClient<njson_adapter>();
+            auto vec = client.template call_func<std::vector<uint64_t>>(
+                "GenRandInts", min_num, max_num, num_rands);
+
+            std::vector<rpc_hpp::batched_call<uint64_t, uint64_t&>> calls;
+            calls.reserve(vec.size());
+
+            for (auto& val : vec)
+            {
+                calls.push_back(rpc_hpp::batch_call<uint64_t>("Fibonacci", val));
+            }
+
+            const auto results = client.call_batch(std::move(calls));
+
+            for (size_t i = 0; i < vec.size(); ++i)
+            {
+                vec[i] = results[i].get();
+            }
+
+            nanobench::doNotOptimizeAway(
+                client.template call_func<double>("AverageContainer<uint64_t>", vec));
+        });
+
+    b.run("rpc.hpp (asio::tcp, njson, mapped)",
+        [&]
+        {
+            auto& client = GetClient<njson_adapter>();
+            auto vec = client.template call_func<std::vector<uint64_t>>(
+                "GenRandInts", min_num, max_num, num_rands);
+
+            const std::vector<std::tuple<uint64_t>> arg_sets(vec.begin(), vec.end());
+            const auto results = client.template call_map<uint64_t>("Fibonacci", arg_sets);
+
+            for (size_t i = 0; i < vec.size(); ++i)
+            {
+                vec[i] = results[i].get();
+            }
+
+            nanobench::doNotOptimizeAway(
+                client.template call_func<double>("AverageContainer<uint64_t>", vec));
+        });
+
+    b.run("rpc.hpp (asio::tcp, njson, chained)",
+        [&]
+        {
+            nanobench::doNotOptimizeAway(GetClient<njson_adapter>().call_chain(
+                rpc_hpp::chain_call<std::vector<uint64_t>>(
+                    "GenRandInts", min_num, max_num, num_rands),
+                rpc_hpp::chain_map<uint64_t>("Fibonacci", rpc_hpp::chain_ref<0>{}),
+                rpc_hpp::chain_call<double>(
+                    "AverageContainer<uint64_t>", rpc_hpp::chain_ref<1>{})));
+        });
+
 #if defined(RPC_HPP_ENABLE_RAPIDJSON)
     b.run("rpc.hpp (asio::tcp, rapidjson)",
         [&]
@@ -331,6 +487,29 @@ TEST_CASE("Sequential")
 #endif
 }
 
+TEST_CASE("Message Size")
+{
+    const ComplexObject cx{ 24, "Franklin D. Roosevelt", false, true,
+        { 0, 1, 4, 6, 7, 8, 11, 15, 17, 22, 25, 26 } };
+
+    const std::vector<double> vec{ 55.65, 125.325, 552.125, 12.767, 2599.6, 1245.125663, 9783.49,
+        125.12, 553.3333333333, 2266.1 };
+
+    const std::string hash = "467365747274747d315a473a527073796c7e707b85";
+    const std::vector<uint64_t> rand_ints(1'000, 17);
+
+    std::cout << "\n| adapter | function | request (bytes) | response (bytes) |\n"
+              << "|---|---|--:|--:|\n";
+
+    print_message_sizes("Fibonacci", uint64_t{ 10946 }, uint64_t{ 20 });
+    print_message_sizes("HashComplex", hash, cx);
+    print_message_sizes("StdDev", 3313.695594785, 55.65, 125.325, 552.125, 12.767, 2599.6,
+        1245.125663, 9783.49, 125.12, 553.3333333333, 2266.1);
+
+    print_message_sizes("AverageContainer<double>", 1731.8635996333, vec);
+    print_message_sizes("GenRandInts", rand_ints, uint64_t{ 5 }, uint64_t{ 30 }, size_t{ 1'000 });
+}
+
 TEST_CASE("KillServer")
 {
 #if defined(RPC_HPP_BENCH_RPCLIB)
@@ -69,6 +69,13 @@ void RpcServer::Run()
                 }
 
                 const auto bytes = dispatch({data, data + len});
+
+                // One-way calls are not answered
+                if (bytes.empty())
+                {
+                    continue;
+                }
+
                 write(sock, asio::buffer(bytes, bytes.size()));
             }
         }
@@ -46,6 +46,8 @@
 #  define RPC_HPP_MODULE_IMPL
 ///@brief Indicates that rpc.hpp is being consumed by a server translation unit
 #  define RPC_HPP_SERVER_IMPL
+///@brief Defined by rpc.hpp when the compiler supports C++20 coroutines, enabling the coroutine API
+#  define RPC_HPP_HAS_COROUTINES
 #endif
 
 #if !defined(RPC_HPP_CLIENT_IMPL) && !defined(RPC_HPP_SERVER_IMPL) && !defined(RPC_HPP_MODULE_IMPL)
@@ -54,16 +56,50 @@
 
 #include <cassert>     // for assert
 #include <cstddef>     // for size_t
+#include <cstdint>     // for uint64_t
+#include <limits>      // for numeric_limits
 #include <optional>    // for nullopt, optional
 #include <stdexcept>   // for runtime_error
 #include <string>      // for string
 #include <tuple>       // for tuple, forward_as_tuple
 #include <type_traits> // for declval, false_type, is_same, integral_constant
 #include <utility>     // for move, index_sequence, make_index_sequence
+#include <vector>      // for vector
 
 #if defined(RPC_HPP_MODULE_IMPL) || defined(RPC_HPP_SERVER_IMPL)
-#  include <functional>    // for function
-#  include <unordered_map> // for unordered_map
+#  include <algorithm>          // for min
+#  include <any>                // for any, any_cast
+#  include <atomic>             // for atomic
+#  include <condition_variable> // for condition_variable
+#  include <deque>              // for deque
+#  include <exception>          // for exception_ptr, current_exception, rethrow_exception
+#  include <functional>         // for function
+#  include <future>             // for future, packaged_task
+#  include <memory>             // for make_shared, make_unique, unique_ptr
+#  include <mutex>              // for lock_guard, mutex, unique_lock
+#  include <thread>             // for thread
+#  include <unordered_map>      // for unordered_map
+#endif
+
+#if defined(RPC_HPP_CLIENT_IMPL)
+#  include <atomic>             // for atomic
+#  include <condition_variable> // for condition_variable
+#  include <exception>          // for exception_ptr, current_exception, rethrow_exception
+#  include <functional>         // for function
+#  include <future>             // for future, promise
+#  include <map>                // for map
+#  include <memory>             // for make_shared, shared_ptr
+#  include <mutex>              // for lock_guard, mutex, unique_lock
+#  include <thread>             // for get_id, thread::id
+#  include <unordered_map>      // for unordered_map
+#  include <unordered_set>      // for unordered_set
+#endif
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#  define RPC_HPP_HAS_COROUTINES
+#  include <coroutine> // for coroutine_handle, noop_coroutine, suspend_always, suspend_never
+#  include <exception> // for exception_ptr, current_exception, rethrow_exception, terminate
+#  include <future>    // for promise
 #endif
 
 #if defined(RPC_HPP_SERVER_IMPL) || defined(RPC_HPP_MODULE_IMPL)
@@ -393,6 +429,24 @@ namespace detail
         for_each_tuple(tuple, func, std::make_index_sequence<sizeof...(Ts)>());
     }
 
+    // Only visits the elements whose bit is set in the mask
+    template<typename F, typename... Ts, size_t... Is>
+    constexpr void for_each_tuple(const std::tuple<Ts...>& tuple,
+        [[maybe_unused]] const uint64_t mask, const F& func,
+        [[maybe_unused]] std::index_sequence<Is...> iseq)
+    {
+        using expander = int[];
+        std::ignore = expander{ 0,
+            (((mask >> Is) & 1U) != 0 ? ((void)func(std::get<Is>(tuple)), 0) : 0)... };
+    }
+
+    template<typename F, typename... Ts>
+    constexpr void for_each_tuple(
+        const std::tuple<Ts...>& tuple, const uint64_t mask, const F& func)
+    {
+        for_each_tuple(tuple, mask, func, std::make_index_sequence<sizeof...(Ts)>());
+    }
+
 #  if defined(RPC_HPP_CLIENT_IMPL)
     // Allows passing in string literals
     template<typename T>
@@ -434,40 +488,246 @@ namespace detail
     template<typename T>
     using decay_str_t = typename decay_str<T>::type;
 
+    // Arguments are referred to when serializing a request, only string literals are copied
+    template<typename T>
+    using request_arg_t = std::conditional_t<std::is_same_v<decay_str_t<T>, T>,
+        const std::remove_reference_t<T>&, std::string>;
+
+    // Prepared calls take reference arguments as declared, and everything else by const reference
+    template<typename T>
+    using prepared_arg_t = std::conditional_t<std::is_reference_v<T>, T, const T&>;
+
+    // Only the elements whose bit is set in the mask are assigned back, they are moved out of src
     template<typename... Args, size_t... Is>
     constexpr void tuple_bind(
-        const std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>& src,
-        std::index_sequence<Is...>, Args&&... dest)
+        std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>&& src,
+        [[maybe_unused]] const uint64_t mask, std::index_sequence<Is...>, Args&&... dest)
     {
         using expander = int[];
         std::ignore = expander{ 0,
             (
-                (void)[](auto&& x, auto&& y) {
+                (void)[mask](auto&& x, auto&& y, const size_t index) {
                     if constexpr (
                         std::is_reference_v<
                             decltype(x)> && !std::is_const_v<std::remove_reference_t<decltype(x)>> && !std::is_pointer_v<std::remove_reference_t<decltype(x)>>)
                     {
-                        x = std::forward<decltype(y)>(y);
+                        if (((mask >> index) & 1U) != 0)
+                        {
+                            x = std::forward<decltype(y)>(y);
+                        }
                     }
-                }(dest, std::get<Is>(src)),
+                }(dest, std::get<Is>(std::move(src)), Is),
                 0)... };
     }
 
     template<typename... Args>
     constexpr void tuple_bind(
-        const std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>& src,
-        Args&&... dest)
+        std::tuple<std::remove_cv_t<std::remove_reference_t<decay_str_t<Args>>>...>&& src,
+        const uint64_t mask, Args&&... dest)
+    {
+        tuple_bind(std::move(src), mask, std::make_index_sequence<sizeof...(Args)>(),
+            std::forward<Args>(dest)...);
+    }
+#  endif
+
+#  if defined(RPC_HPP_SERVER_IMPL) || defined(RPC_HPP_MODULE_IMPL)
+    // Like std::apply, but arguments taken by value are moved into the function, as only
+    // (non-const) reference arguments are sent back in the response
+    template<typename... Args, typename F, typename Tuple>
+    constexpr decltype(auto) apply_args(F&& func, Tuple& args)
     {
-        tuple_bind(src, std::make_index_sequence<sizeof...(Args)>(), std::forward<Args>(dest)...);
+        static_assert(sizeof...(Args) == std::tuple_size_v<Tuple>,
+            "Argument types must match the argument tuple");
+
+        return std::apply(
+            [&func](auto&... call_args) -> decltype(auto) {
+                return std::forward<F>(func)(std::forward<Args>(call_args)...);
+            },
+            args);
     }
+
+    // Fixed-size pool where each worker has its own queue, and idle workers steal from the others
+    class thread_pool
+    {
+    public:
+        explicit thread_pool(const size_t thread_count) : m_queues(thread_count)
+        {
+            RPC_HPP_PRECONDITION(thread_count > 0);
+
+            m_threads.reserve(thread_count);
+
+            for (size_t i = 0; i < thread_count; ++i)
+            {
+                m_threads.emplace_back([this, i] { worker_loop(i); });
+            }
+        }
+
+        ~thread_pool() noexcept
+        {
+            {
+                std::lock_guard<std::mutex> lock{ m_mtx };
+                m_stopping = true;
+            }
+
+            m_cv.notify_all();
+
+            for (auto& thread : m_threads)
+            {
+                thread.join();
+            }
+        }
+
+        thread_pool(const thread_pool&) = delete;
+        thread_pool(thread_pool&&) = delete;
+        thread_pool& operator=(const thread_pool&) = delete;
+        thread_pool& operator=(thread_pool&&) = delete;
+
+        size_t size() const noexcept { return m_queues.size(); }
+
+        template<typename F>
+        std::future<void> submit(F&& func)
+        {
+            const auto job = std::make_shared<std::packaged_task<void()>>(std::forward<F>(func));
+            auto result = job->get_future();
+
+            // Jobs submitted by a worker go on its own queue, where it runs them first
+            const auto& worker = current_worker();
+            auto& queue = m_queues[(worker.pool == this) ? worker.index
+                                                          : m_next_queue++ % m_queues.size()];
+
+            {
+                std::lock_guard<std::mutex> queue_lock{ queue.mtx };
+                queue.jobs.emplace_back([job] { (*job)(); });
+                ++m_pending;
+            }
+
+            // Taking the lock orders the count before a parked worker's check of it
+            {
+                std::lock_guard<std::mutex> lock{ m_mtx };
+            }
+
+            m_cv.notify_one();
+            return result;
+        }
+
+    private:
+        struct work_queue
+        {
+            std::mutex mtx{};
+            std::deque<std::function<void()>> jobs{};
+        };
+
+        struct worker_info
+        {
+            const thread_pool* pool;
+            size_t index;
+        };
+
+        static worker_info& current_worker() noexcept
+        {
+            thread_local worker_info worker{ nullptr, 0 };
+            return worker;
+        }
+
+        bool try_pop(const size_t index, std::function<void()>& job)
+        {
+            // Newest job from the worker's own queue first, then the oldest from another queue
+            {
+                auto& own = m_queues[index];
+                std::lock_guard<std::mutex> lock{ own.mtx };
+
+                if (!own.jobs.empty())
+                {
+                    job = std::move(own.jobs.back());
+                    own.jobs.pop_back();
+                    --m_pending;
+                    return true;
+                }
+            }
+
+            for (size_t i = 1; i < m_queues.size(); ++i)
+            {
+                auto& other = m_queues[(index + i) % m_queues.size()];
+                std::lock_guard<std::mutex> lock{ other.mtx };
+
+                if (!other.jobs.empty())
+                {
+                    job = std::move(other.jobs.front());
+                    other.jobs.pop_front();
+                    --m_pending;
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void worker_loop(const size_t index)
+        {
+            current_worker() = { this, index };
+
+            while (true)
+            {
+                std::function<void()> job;
+
+                if (try_pop(index, job))
+                {
+                    job();
+                    continue;
+                }
+
+                // Only parks once every queue is empty, and only stops once all jobs have run
+                std::unique_lock<std::mutex> lock{ m_mtx };
+                m_cv.wait(lock, [this] { return m_stopping || m_pending > 0; });
+
+                if (m_pending == 0)
+                {
+                    return;
+                }
+            }
+        }
+
+        std::vector<work_queue> m_queues;
+        std::vector<std::thread> m_threads{};
+        std::atomic<size_t> m_next_queue{ 0 };
+        std::atomic<size_t> m_pending{ 0 };
+        std::mutex m_mtx{};
+        std::condition_variable m_cv{};
+        bool m_stopping{ false };
+    };
 #  endif
 
+    // Call ID reserved for one-way calls, which are never answered
+    inline constexpr uint64_t oneway_call_id = std::numeric_limits<uint64_t>::max();
+
+    // Arguments a callback may change, which are the only ones sent back in a response
+    template<typename T>
+    inline constexpr bool is_output_arg_v =
+        std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>;
+
+    template<typename... Args, size_t... Is>
+    constexpr uint64_t output_arg_mask([[maybe_unused]] std::index_sequence<Is...> iseq) noexcept
+    {
+        return ((is_output_arg_v<Args> ? uint64_t{ 1 } << Is : uint64_t{}) | ... | uint64_t{});
+    }
+
+    template<typename... Args>
+    constexpr uint64_t output_arg_mask() noexcept
+    {
+        return output_arg_mask<Args...>(std::index_sequence_for<Args...>{});
+    }
+
     template<typename... Args>
     class packed_func_base
     {
     public:
         using args_t = std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>;
 
+        static_assert(sizeof...(Args) < 64, "Functions are limited to 63 arguments");
+
+        // Mask with a bit set for every argument
+        static constexpr uint64_t all_args = (uint64_t{ 1 } << sizeof...(Args)) - 1;
+
         packed_func_base() = delete;
         packed_func_base(std::string func_name, args_t args) noexcept
             : m_func_name(std::move(func_name)), m_args(std::move(args))
@@ -475,18 +735,31 @@ namespace detail
         }
 
         explicit operator bool() const noexcept { return m_except_type == exception_type::none; }
+        uint64_t get_call_id() const noexcept { return m_call_id; }
         const std::string& get_err_mesg() const noexcept { return m_err_mesg; }
         const std::string& get_func_name() const noexcept { return m_func_name; }
         exception_type get_except_type() const noexcept { return m_except_type; }
 
+        uint64_t get_arg_mask() const noexcept { return m_arg_mask; }
+
+        ///@brief Gets whether the argument at @p index is carried by the pack
+        bool has_arg(const size_t index) const noexcept
+        {
+            return ((m_arg_mask >> index) & 1U) != 0;
+        }
+
+        void set_call_id(const uint64_t call_id) & noexcept { m_call_id = call_id; }
+        void set_arg_mask(const uint64_t arg_mask) & noexcept { m_arg_mask = arg_mask; }
+
         void set_exception(std::string&& mesg, const exception_type type) & noexcept
         {
             m_except_type = type;
             m_err_mesg = std::move(mesg);
         }
 
-        const args_t& get_args() const noexcept { return m_args; }
-        args_t& get_args() noexcept { return m_args; }
+        const args_t& get_args() const& noexcept { return m_args; }
+        args_t& get_args() & noexcept { return m_args; }
+        args_t&& get_args() && noexcept { return std::move(m_args); }
 
     protected:
         ~packed_func_base() noexcept = default;
@@ -534,6 +807,8 @@ namespace detail
 
     private:
         exception_type m_except_type{ exception_type::none };
+        uint64_t m_call_id{};
+        uint64_t m_arg_mask{ all_args };
         std::string m_func_name;
         std::string m_err_mesg{};
         args_t m_args;
@@ -557,7 +832,7 @@ namespace detail
             return m_result.has_value() && packed_func_base<Args...>::operator bool();
         }
 
-        const R& get_result() const
+        const R& get_result() const&
         {
             if (!static_cast<bool>(*this))
             {
@@ -568,6 +843,18 @@ namespace detail
             return m_result.value();
         }
 
+        ///@brief Moves the result out of an expiring pack rather than copying it
+        R get_result() &&
+        {
+            if (!static_cast<bool>(*this))
+            {
+                // throws exception based on except_type
+                this->throw_ex();
+            }
+
+            return std::move(m_result).value();
+        }
+
         void set_result(const R& value) & noexcept(std::is_nothrow_copy_assignable_v<R>)
         {
             m_result = value;
@@ -603,6 +890,31 @@ namespace detail
         }
     };
 
+    // Refers to the caller's function name and arguments, so a request can be serialized without
+    // copying them first
+    template<typename... Args>
+    class request_view
+    {
+    public:
+        using args_t = std::tuple<const std::remove_cv_t<std::remove_reference_t<Args>>&...>;
+
+        static_assert(sizeof...(Args) < 64, "Functions are limited to 63 arguments");
+
+        request_view(const uint64_t call_id, const std::string& func_name, args_t args) noexcept
+            : m_call_id(call_id), m_func_name(func_name), m_args(std::move(args))
+        {
+        }
+
+        uint64_t get_call_id() const noexcept { return m_call_id; }
+        const std::string& get_func_name() const noexcept { return m_func_name; }
+        const args_t& get_args() const noexcept { return m_args; }
+
+    private:
+        uint64_t m_call_id;
+        const std::string& m_func_name;
+        args_t m_args;
+    };
+
     template<typename Adapter>
     struct serial_adapter_base
     {
@@ -613,12 +925,47 @@ namespace detail
         static bytes_t to_bytes(serial_t&& serial_obj) = delete;
         static serial_t empty_object() = delete;
 
+        // Requests carry the function name and every argument, adapters may also use the return
+        // type to identify the signature of the call
         template<typename R, typename... Args>
-        static serial_t serialize_pack(const packed_func<R, Args...>& pack) = delete;
+        static serial_t serialize_request(const request_view<Args...>& request) = delete;
 
+        // Prepared requests are built once per function, then completed with the call ID and
+        // arguments of each call
         template<typename R, typename... Args>
-        static packed_func<R, Args...> deserialize_pack(const serial_t& serial_obj) = delete;
+        static serial_t prepare_request(const std::string& func_name) = delete;
 
+        template<typename... Args>
+        static serial_t serialize_prepared(
+            const serial_t& prepared, const request_view<Args...>& request) = delete;
+
+        template<typename R, typename... Args>
+        static packed_func<R, Args...> deserialize_request(const serial_t& serial_obj) = delete;
+
+        // Responses carry the result (or error) and the arguments in the pack's argument mask
+        template<typename R, typename... Args>
+        static serial_t serialize_response(const packed_func<R, Args...>& pack) = delete;
+
+        template<typename R, typename... Args>
+        static packed_func<R, Args...> deserialize_response(const serial_t& serial_obj) = delete;
+
+        // Reads the result into existing storage, the returned pack only holds the arguments
+        template<typename R, typename... Args>
+        static packed_func<void, Args...> deserialize_response_into(
+            const serial_t& serial_obj, R& result) = delete;
+
+        static serial_t make_batch(uint64_t call_id, std::vector<serial_t>&& serial_objs) = delete;
+        static bool is_batch(const serial_t& serial_obj) = delete;
+        static std::vector<std::optional<serial_t>> split_batch(serial_t&& serial_obj) = delete;
+        static serial_t make_map(uint64_t call_id, const std::string& func_name,
+            std::vector<serial_t>&& serial_objs) = delete;
+
+        static bool is_map(const serial_t& serial_obj) = delete;
+        static std::vector<std::optional<serial_t>> split_map(serial_t&& serial_obj) = delete;
+        static serial_t make_chain(uint64_t call_id, std::vector<serial_t>&& serial_objs) = delete;
+        static bool is_chain(const serial_t& serial_obj) = delete;
+        static std::vector<std::optional<serial_t>> split_chain(serial_t&& serial_obj) = delete;
+        static uint64_t get_call_id(const serial_t& serial_obj) = delete;
         static std::string get_func_name(const serial_t& serial_obj) = delete;
         static rpc_exception extract_exception(const serial_t& serial_obj) = delete;
         static void set_exception(serial_t& serial_obj, const rpc_exception& ex) = delete;
@@ -626,6 +973,206 @@ namespace detail
 #endif
 } // namespace detail
 
+#if defined(RPC_HPP_HAS_COROUTINES)
+template<typename T>
+class task;
+
+namespace detail
+{
+    class task_promise_base
+    {
+    public:
+        struct final_awaiter
+        {
+            bool await_ready() const noexcept { return false; }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(
+                std::coroutine_handle<Promise> handle) const noexcept
+            {
+                return handle.promise().get_continuation();
+            }
+
+            void await_resume() const noexcept {}
+        };
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        final_awaiter final_suspend() const noexcept { return {}; }
+        void unhandled_exception() noexcept { m_error = std::current_exception(); }
+
+        std::coroutine_handle<> get_continuation() const noexcept { return m_continuation; }
+
+        void set_continuation(const std::coroutine_handle<> continuation) & noexcept
+        {
+            m_continuation = continuation;
+        }
+
+    protected:
+        void rethrow_if_error() const
+        {
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+    private:
+        std::coroutine_handle<> m_continuation{ std::noop_coroutine() };
+        std::exception_ptr m_error{};
+    };
+
+    template<typename T>
+    class task_promise : public task_promise_base
+    {
+    public:
+        task<T> get_return_object() noexcept;
+        void return_value(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            m_result.emplace(std::move(value));
+        }
+
+        T get_result()
+        {
+            rethrow_if_error();
+            return std::move(m_result).value();
+        }
+
+    private:
+        std::optional<T> m_result{};
+    };
+
+    template<>
+    class task_promise<void> : public task_promise_base
+    {
+    public:
+        task<void> get_return_object() noexcept;
+        void return_void() const noexcept {}
+        void get_result() const { rethrow_if_error(); }
+    };
+
+    // Coroutine that starts immediately and cleans itself up, used to drive tasks to completion
+    struct detached_task
+    {
+        struct promise_type
+        {
+            detached_task get_return_object() const noexcept { return {}; }
+            std::suspend_never initial_suspend() const noexcept { return {}; }
+            std::suspend_never final_suspend() const noexcept { return {}; }
+            void return_void() const noexcept {}
+            [[noreturn]] void unhandled_exception() const noexcept { std::terminate(); }
+        };
+    };
+} // namespace detail
+
+///@brief Lazily started coroutine that produces a value when awaited
+///
+///@tparam T Type of the value produced by the coroutine
+///@note Only available when compiling with C++20 coroutine support (see @ref RPC_HPP_HAS_COROUTINES)
+template<typename T = void>
+class [[nodiscard]] task
+{
+public:
+    using promise_type = detail::task_promise<T>;
+
+    ~task() noexcept
+    {
+        if (m_handle)
+        {
+            m_handle.destroy();
+        }
+    }
+
+    // Prevent copying
+    task(const task&) = delete;
+    task& operator=(const task&) = delete;
+
+    task(task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+    task& operator=(task&& other) & noexcept
+    {
+        if (this != &other)
+        {
+            if (m_handle)
+            {
+                m_handle.destroy();
+            }
+
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+
+        return *this;
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(const std::coroutine_handle<> continuation) noexcept
+    {
+        RPC_HPP_PRECONDITION(m_handle);
+
+        m_handle.promise().set_continuation(continuation);
+        return m_handle;
+    }
+
+    T await_resume() { return m_handle.promise().get_result(); }
+
+private:
+    friend promise_type;
+
+    explicit task(const std::coroutine_handle<promise_type> handle) noexcept : m_handle(handle) {}
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+namespace detail
+{
+    template<typename T>
+    task<T> task_promise<T>::get_return_object() noexcept
+    {
+        return task<T>{ std::coroutine_handle<task_promise>::from_promise(*this) };
+    }
+
+    inline task<void> task_promise<void>::get_return_object() noexcept
+    {
+        return task<void>{ std::coroutine_handle<task_promise>::from_promise(*this) };
+    }
+
+    template<typename T>
+    detached_task start_task(task<T> work, std::promise<T> result)
+    {
+        try
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                co_await std::move(work);
+                result.set_value();
+            }
+            else
+            {
+                result.set_value(co_await std::move(work));
+            }
+        }
+        catch (...)
+        {
+            result.set_exception(std::current_exception());
+        }
+    }
+} // namespace detail
+
+///@brief Runs a task to completion, blocking the calling thread until it finishes
+///
+///@tparam T Type of the value produced by the task
+///@param work Task to run
+///@return T Value produced by the task, will rethrow any exception thrown by the task
+template<typename T>
+T sync_wait(task<T> work)
+{
+    std::promise<T> result;
+    auto fut = result.get_future();
+    detail::start_task(std::move(work), std::move(result));
+    return fut.get();
+}
+#endif
+
 #if defined(RPC_HPP_SERVER_IMPL) || defined(RPC_HPP_MODULE_IMPL)
 ///@brief Namespace containing functions and classes only relevant to "server-side" implentations
 ///
@@ -656,21 +1203,38 @@ inline namespace server
         ///@tparam Val Type of the return value for a function
         ///@param func_name Name of the function to get the cached return value(s) for
         ///@return std::unordered_map<typename Serial::bytes_t, Val>& Reference to the hashmap containing the return values with the serialized function call as the key
+        ///@note The cache is updated by calls as they are dispatched, so it must not be used while
+        /// the server is handling calls on other threads
         template<typename Val>
         std::unordered_map<typename Serial::bytes_t, Val>& get_func_cache(
             const std::string& func_name)
         {
             RPC_HPP_PRECONDITION(!func_name.empty());
 
-            update_all_cache<Val>(func_name);
-            return *static_cast<std::unordered_map<typename Serial::bytes_t, Val>*>(
-                m_cache_map.at(func_name));
+            std::lock_guard<std::mutex> lock{ *m_cache_mtx };
+            return *get_func_cache_impl<Val>(func_name);
         }
 
         ///@brief Clears the server's function cache
-        RPC_HPP_INLINE void clear_all_cache() noexcept { m_cache_map.clear(); }
+        RPC_HPP_INLINE void clear_all_cache() noexcept
+        {
+            std::lock_guard<std::mutex> lock{ *m_cache_mtx };
+            m_cache_map.clear();
+        }
 #  endif
 
+        ///@brief Sets the number of worker threads used to run the calls in a batch concurrently
+        ///
+        ///@param worker_count Number of worker threads, 0 runs the calls in order on the dispatching
+        ///thread (the default)
+        ///@note Responses are still gathered in the order of the calls
+        ///@note Bound callbacks must be safe to call concurrently when workers are enabled
+        void set_worker_count(const size_t worker_count)
+        {
+            m_workers =
+                (worker_count == 0) ? nullptr : std::make_unique<detail::thread_pool>(worker_count);
+        }
+
         ///@brief Binds a string to a callback, utilizing the server's cache
         ///
         ///@tparam R Return type of the callback function
@@ -680,18 +1244,22 @@ inline namespace server
         template<typename R, typename... Args>
         void bind_cached(std::string func_name, R (*func_ptr)(Args...))
         {
-            m_dispatch_table.emplace(std::move(func_name),
-                [this, func_ptr](typename Serial::serial_t& serial_obj)
+            // The cache is keyed by the bound name, as calls in a map do not carry their own
+            m_dispatch_table.emplace(func_name,
+                [this, func_ptr, func_name](typename Serial::serial_t& serial_obj)
                 {
                     try
                     {
-                        dispatch_cached_func(func_ptr, serial_obj);
+                        dispatch_cached_func(func_ptr, func_name, serial_obj);
                     }
                     catch (const rpc_exception& ex)
                     {
                         Serial::set_exception(serial_obj, ex);
                     }
                 });
+
+            // Calls in a chain bypass the cache, their arguments are not all serialized
+            m_chain_table.emplace(std::move(func_name), make_chain_callback<R, Args...>(func_ptr));
         }
 
         ///@brief Binds a string to a callback, utilizing the server's cache
@@ -718,7 +1286,7 @@ inline namespace server
         template<typename R, typename... Args>
         void bind(std::string func_name, R (*func_ptr)(Args...))
         {
-            m_dispatch_table.emplace(std::move(func_name),
+            m_dispatch_table.emplace(func_name,
                 [func_ptr](typename Serial::serial_t& serial_obj)
                 {
                     try
@@ -730,6 +1298,8 @@ inline namespace server
                         Serial::set_exception(serial_obj, ex);
                     }
                 });
+
+            m_chain_table.emplace(std::move(func_name), make_chain_callback<R, Args...>(func_ptr));
         }
 
         ///@brief Binds a string to a callback
@@ -747,42 +1317,141 @@ inline namespace server
             bind(std::move(func_name), fptr_t{ std::forward<F>(func) });
         }
 
+#  if defined(RPC_HPP_HAS_COROUTINES)
+        ///@brief Binds a string to a coroutine callback
+        ///
+        ///@tparam R Type of the value produced by the coroutine
+        ///@tparam Args Variadic argument type(s) for the coroutine
+        ///@param func_name Name to bind the coroutine to
+        ///@param func_ptr Pointer to coroutine that runs when dispatch is called with bound name
+        ///@note The coroutine may co_await other I/O (including nested RPCs) without holding a
+        /// thread when dispatched with @ref dispatch_async
+        template<typename R, typename... Args>
+        void bind_coroutine(std::string func_name, task<R> (*func_ptr)(Args...))
+        {
+            // Blocking dispatch waits on the coroutine, dispatch_async does not
+            m_dispatch_table.emplace(func_name,
+                [func_ptr](typename Serial::serial_t& serial_obj)
+                { sync_wait(dispatch_coroutine(func_ptr, serial_obj)); });
+
+            m_co_dispatch_table.emplace(func_name,
+                [func_ptr](typename Serial::serial_t& serial_obj)
+                { return dispatch_coroutine(func_ptr, serial_obj); });
+
+            m_chain_table.emplace(std::move(func_name),
+                make_chain_callback<R, Args...>([func_ptr](auto&&... args)
+                    { return sync_wait(func_ptr(std::forward<decltype(args)>(args)...)); }));
+        }
+
+        ///@brief Binds a string to a coroutine callback
+        ///
+        ///@tparam R Type of the value produced by the coroutine
+        ///@tparam Args Variadic argument type(s) for the coroutine
+        ///@tparam F Callback type (could be function or lambda or functor)
+        ///@param func_name Name to bind the coroutine to
+        ///@param func Coroutine to run when dispatch is called with bound name
+        template<typename R, typename... Args, typename F>
+        RPC_HPP_INLINE void bind_coroutine(std::string func_name, F&& func)
+        {
+            using fptr_t = task<R> (*)(Args...);
+
+            bind_coroutine(std::move(func_name), fptr_t{ std::forward<F>(func) });
+        }
+#  endif
+
         ///@brief Parses the received serialized data and determines which function to call
         ///
         ///@param bytes Data to be parsed into a serial object
         ///@return Serial::bytes_t Data parsed out of a serial object after dispatching the callback
         ///@note nodiscard because original bytes are consumed
+        ///@note The response carries the call ID of the request, so a server may dispatch several
+        ///requests from one connection concurrently and send the responses as they finish
+        ///@note Coroutine bindings are run to completion on the calling thread, prefer
+        ///@ref dispatch_async for those
+        ///@note A batch or map of calls is answered with one combined response, the calls are run in
+        ///order unless workers are enabled with @ref set_worker_count
+        ///@note A chain of calls is run in order, passing results from call to call without
+        ///serializing them, and is answered with only the result of the final call
+        ///@note One-way calls are run but return empty data, which should not be sent
         [[nodiscard]] typename Serial::bytes_t dispatch(typename Serial::bytes_t&& bytes) const
         {
             auto serial_obj = Serial::from_bytes(std::move(bytes));
 
-            if (!serial_obj.has_value())
+            if (serial_obj.has_value() && Serial::is_batch(serial_obj.value()))
             {
-                auto err_obj = Serial::empty_object();
-                Serial::set_exception(err_obj, server_receive_error("Invalid RPC object received"));
-                return Serial::to_bytes(std::move(err_obj));
+                return Serial::to_bytes(dispatch_batch(std::move(serial_obj).value()));
             }
 
-            const auto func_name = adapter_t::get_func_name(serial_obj.value());
+            if (serial_obj.has_value() && Serial::is_map(serial_obj.value()))
+            {
+                return Serial::to_bytes(dispatch_map(std::move(serial_obj).value()));
+            }
+
+            if (serial_obj.has_value() && Serial::is_chain(serial_obj.value()))
+            {
+                return Serial::to_bytes(dispatch_chain(std::move(serial_obj).value()));
+            }
+
+            return make_response(dispatch_single(std::move(serial_obj)));
+        }
+
+#  if defined(RPC_HPP_HAS_COROUTINES)
+        ///@brief Parses the received serialized data and determines which function to call,
+        /// without waiting for coroutine bindings to finish
+        ///
+        ///@param bytes Data to be parsed into a serial object
+        ///@param on_done Handler to invoke with the response data once the callback has finished
+        ///@note Callbacks bound with @ref bind_coroutine complete wherever their last awaited
+        /// operation resumes them, so @p on_done may be invoked on another thread (and must not
+        /// throw)
+        ///@note Coroutine bindings called in a batch, map or chain are run to completion on the
+        /// calling thread
+        ///@note One-way calls invoke @p on_done with empty data, which should not be sent
+        void dispatch_async(typename Serial::bytes_t&& bytes,
+            std::function<void(typename Serial::bytes_t&&)> on_done) const
+        {
+            auto serial_obj = Serial::from_bytes(std::move(bytes));
+
+            if (serial_obj.has_value() && Serial::is_batch(serial_obj.value()))
+            {
+                on_done(Serial::to_bytes(dispatch_batch(std::move(serial_obj).value())));
+                return;
+            }
 
-            if (const auto it = m_dispatch_table.find(func_name); it != m_dispatch_table.end())
+            if (serial_obj.has_value() && Serial::is_map(serial_obj.value()))
             {
-                it->second(serial_obj.value());
-                return Serial::to_bytes(std::move(serial_obj).value());
+                on_done(Serial::to_bytes(dispatch_map(std::move(serial_obj).value())));
+                return;
             }
 
-            Serial::set_exception(serial_obj.value(),
-                function_not_found("RPC error: Called function: \"" + func_name + "\" not found"));
+            if (serial_obj.has_value() && Serial::is_chain(serial_obj.value()))
+            {
+                on_done(Serial::to_bytes(dispatch_chain(std::move(serial_obj).value())));
+                return;
+            }
+
+            if (serial_obj.has_value())
+            {
+                if (const auto it = m_co_dispatch_table.find(
+                        adapter_t::get_func_name(serial_obj.value()));
+                    it != m_co_dispatch_table.end())
+                {
+                    run_coroutine(it->second, std::move(serial_obj).value(), std::move(on_done));
+                    return;
+                }
+            }
 
-            return Serial::to_bytes(std::move(serial_obj).value());
+            on_done(make_response(dispatch_single(std::move(serial_obj))));
         }
+#  endif
 
     protected:
         ~server_interface() noexcept = default;
 
 #  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
         template<typename R, typename... Args>
-        void dispatch_cached_func(R (*func)(Args...), typename Serial::serial_t& serial_obj)
+        void dispatch_cached_func(R (*func)(Args...), const std::string& func_name,
+            typename Serial::serial_t& serial_obj)
         {
             RPC_HPP_PRECONDITION(func != nullptr);
 
@@ -790,7 +1459,7 @@ inline namespace server
             {
                 try
                 {
-                    return Serial::template deserialize_pack<R, Args...>(serial_obj);
+                    return Serial::template deserialize_request<R, Args...>(serial_obj);
                 }
                 catch (const rpc_exception&)
                 {
@@ -802,56 +1471,56 @@ inline namespace server
                 }
             }();
 
-            auto& result_cache = get_func_cache<R>(pack.get_func_name());
+            [[maybe_unused]] auto bytes = make_cache_key(pack);
+
+            // The cache is shared, but the callback is run without holding the lock (the cache is
+            // kept alive by its pointer if it is cleared in the meantime)
+            std::unique_lock<std::mutex> lock{ *m_cache_mtx };
+            const auto cache_ptr = get_func_cache_impl<R>(func_name);
+            auto& result_cache = *cache_ptr;
 
             if constexpr (!std::is_void_v<R>)
             {
-                auto bytes = Serial::to_bytes(std::move(serial_obj));
-
                 if (const auto it = result_cache.find(bytes); it != result_cache.end())
                 {
                     pack.set_result(it->second);
+                    lock.unlock();
 
-                    try
+                    if (pack.get_call_id() == detail::oneway_call_id)
                     {
-                        serial_obj = Serial::template serialize_pack<R, Args...>(pack);
                         return;
                     }
-                    catch (const rpc_exception&)
-                    {
-                        throw;
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        throw serialization_error(ex.what());
-                    }
+
+                    serial_obj = serialize_response(pack);
+                    return;
                 }
 
+                lock.unlock();
                 run_callback(func, pack);
-                result_cache[std::move(bytes)] = pack.get_result();
+
+                lock.lock();
+                result_cache.insert_or_assign(std::move(bytes), pack.get_result());
+                lock.unlock();
             }
             else
             {
+                lock.unlock();
                 run_callback(func, pack);
             }
 
-            try
-            {
-                serial_obj = Serial::template serialize_pack<R, Args...>(pack);
-            }
-            catch (const rpc_exception&)
-            {
-                throw;
-            }
-            catch (const std::exception& ex)
+            // One-way calls are never answered, so the result is not serialized
+            if (pack.get_call_id() == detail::oneway_call_id)
             {
-                throw serialization_error(ex.what());
+                return;
             }
+
+            serial_obj = serialize_response(pack);
         }
 #  else
         template<typename R, typename... Args>
-        RPC_HPP_INLINE void dispatch_cached_func(
-            R (*func)(Args...), typename Serial::serial_t& serial_obj) const
+        RPC_HPP_INLINE void dispatch_cached_func(R (*func)(Args...),
+            [[maybe_unused]] const std::string& func_name,
+            typename Serial::serial_t& serial_obj) const
         {
             dispatch_func(func, serial_obj);
         }
@@ -866,7 +1535,7 @@ inline namespace server
             {
                 try
                 {
-                    return Serial::template deserialize_pack<R, Args...>(serial_obj);
+                    return Serial::template deserialize_request<R, Args...>(serial_obj);
                 }
                 catch (const rpc_exception&)
                 {
@@ -880,234 +1549,225 @@ inline namespace server
 
             run_callback(func, pack);
 
-            try
-            {
-                serial_obj = Serial::template serialize_pack<R, Args...>(pack);
-            }
-            catch (const rpc_exception&)
+            // One-way calls are never answered, so the result is not serialized
+            if (pack.get_call_id() == detail::oneway_call_id)
             {
-                throw;
+                return;
             }
-            catch (const std::exception& ex)
+
+            serial_obj = serialize_response(pack);
+        }
+
+    private:
+        using callback_t = std::function<void(typename Serial::serial_t&)>;
+
+        // One-way calls get an empty response, which the transport should not send
+        static typename Serial::bytes_t make_response(typename Serial::serial_t&& serial_obj)
+        {
+            if (Serial::get_call_id(serial_obj) == detail::oneway_call_id)
             {
-                throw serialization_error(ex.what());
+                return {};
             }
+
+            return Serial::to_bytes(std::move(serial_obj));
         }
 
-    private:
-        template<typename R, typename... Args>
-        static void run_callback(R (*func)(Args...), detail::packed_func<R, Args...>& pack)
+        static typename Serial::serial_t make_error(const rpc_exception& ex)
         {
-            RPC_HPP_PRECONDITION(func != nullptr);
+            auto err_obj = Serial::empty_object();
+            Serial::set_exception(err_obj, ex);
+            return err_obj;
+        }
 
-            auto& args = pack.get_args();
+        const callback_t* find_callback(const std::string& func_name) const
+        {
+            const auto it = m_dispatch_table.find(func_name);
+            return it == m_dispatch_table.end() ? nullptr : &it->second;
+        }
 
-            if constexpr (std::is_void_v<R>)
+        static typename Serial::serial_t invoke_callback(const callback_t* callback,
+            const std::string& func_name, typename Serial::serial_t&& serial_obj)
+        {
+            if (callback == nullptr)
             {
-                try
-                {
-                    std::apply(func, args);
-                }
-                catch (const std::exception& ex)
-                {
-                    throw remote_exec_error(ex.what());
-                }
+                Serial::set_exception(serial_obj,
+                    function_not_found(
+                        "RPC error: Called function: \"" + func_name + "\" not found"));
+
+                return std::move(serial_obj);
             }
-            else
+
+            (*callback)(serial_obj);
+            return std::move(serial_obj);
+        }
+
+        typename Serial::serial_t dispatch_single(
+            std::optional<typename Serial::serial_t>&& serial_obj) const
+        {
+            if (!serial_obj.has_value())
             {
-                try
-                {
-                    auto result = std::apply(func, args);
-                    pack.set_result(std::move(result));
-                }
-                catch (const std::exception& ex)
-                {
-                    throw remote_exec_error(ex.what());
-                }
+                return make_error(server_receive_error("Invalid RPC object received"));
+            }
+
+            if (Serial::is_batch(serial_obj.value()) || Serial::is_map(serial_obj.value())
+                || Serial::is_chain(serial_obj.value()))
+            {
+                return make_error(server_receive_error("Nested batches are not supported"));
             }
+
+            const auto func_name = adapter_t::get_func_name(serial_obj.value());
+            return invoke_callback(
+                find_callback(func_name), func_name, std::move(serial_obj).value());
         }
 
-#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
-        template<typename Val>
-        static void* get_func_cache_impl(const std::string& func_name)
+        typename Serial::serial_t dispatch_batch(typename Serial::serial_t&& batch_obj) const
         {
-            static std::unordered_map<std::string,
-                std::unordered_map<typename Serial::bytes_t, Val>>
-                cache{};
+            const auto call_id = Serial::get_call_id(batch_obj);
+            auto requests = Serial::split_batch(std::move(batch_obj));
 
-            return &cache[func_name];
+            auto responses = run_calls(requests,
+                [this](std::optional<typename Serial::serial_t>&& request)
+                { return dispatch_single(std::move(request)); });
+
+            return Serial::make_batch(call_id, std::move(responses));
         }
 
-        template<typename Val>
-        void update_all_cache(const std::string& func_name)
+        typename Serial::serial_t dispatch_map(typename Serial::serial_t&& map_obj) const
         {
-            RPC_HPP_PRECONDITION(!func_name.empty());
+            const auto call_id = Serial::get_call_id(map_obj);
+            const auto func_name = adapter_t::get_func_name(map_obj);
 
-            m_cache_map.insert_or_assign(func_name, get_func_cache_impl<Val>(func_name));
-        }
+            // Every call in a map uses the same function, so it is only looked up once
+            const auto* const callback = find_callback(func_name);
+            auto requests = Serial::split_map(std::move(map_obj));
 
-        std::unordered_map<std::string, void*> m_cache_map{};
-#  endif
+            auto responses = run_calls(requests,
+                [callback, &func_name](std::optional<typename Serial::serial_t>&& request)
+                {
+                    if (!request.has_value())
+                    {
+                        return make_error(server_receive_error("Invalid RPC object received"));
+                    }
 
-        std::unordered_map<std::string, std::function<void(typename Serial::serial_t&)>>
-            m_dispatch_table{};
-    };
-} // namespace server
-#endif
+                    return invoke_callback(callback, func_name, std::move(request).value());
+                });
 
-#if defined(RPC_HPP_CLIENT_IMPL)
-#  define call_header_func(FUNCNAME, ...) call_header_func_impl(FUNCNAME, #  FUNCNAME, __VA_ARGS__)
+            return Serial::make_map(call_id, func_name, std::move(responses));
+        }
 
-///@brief Namespace containing functions and classes only relevant to "client-side" implentations
-///
-///@note Is only compiled by defining @ref RPC_HPP_CLIENT_IMPL
-inline namespace client
-{
-    ///@brief Class defining an interface for calling into an RPC server or module
-    ///
-    ///@tparam Serial serial_adapter type that controls how objects are serialized/deserialized
-    template<typename Serial>
-    class client_interface
-    {
-    public:
-        virtual ~client_interface() noexcept = default;
-        client_interface() noexcept = default;
+        // Results of the calls in a chain, and how many later calls still use each one
+        struct chain_state
+        {
+            std::vector<std::any> results;
+            std::vector<size_t> uses;
+        };
 
-        // Prevent copying
-        client_interface(const client_interface&) = delete;
-        client_interface& operator=(const client_interface&) = delete;
+        using chain_callback_t = std::function<std::any(
+            typename Serial::serial_t&, const std::vector<uint64_t>&, chain_state&, bool)>;
 
-        // Prevent slicing
-        client_interface& operator=(client_interface&&) = delete;
+        // First value of the links sent with each call in a chain
+        static constexpr uint64_t chain_call_mode = 0;
+        static constexpr uint64_t chain_map_mode = 1;
 
-        ///@brief Sends an RPC call request to a server, waits for a response, then returns the result
-        ///
-        ///@tparam R Return type of the remote function to call
-        ///@tparam Args Variadic argument type(s) of the remote function to call
-        ///@param func_name Name of the remote function to call
-        ///@param args Argument(s) for the remote function
-        ///@return R Result of the function call, will throw with server's error message if the result does not exist
-        ///@throws client_send_error Thrown if error occurs during the @ref send function
-        ///@throws client_receive_error Thrown if error occurs during the @ref receive function
-        ///@note nodiscard because an expensive remote procedure call is being performed
-        template<typename R = void, typename... Args>
-        [[nodiscard]] R call_func(std::string func_name, Args&&... args)
+        typename Serial::serial_t dispatch_chain(typename Serial::serial_t&& chain_obj) const
         {
-            RPC_HPP_PRECONDITION(!func_name.empty());
+            const auto call_id = Serial::get_call_id(chain_obj);
+            auto requests = Serial::split_chain(std::move(chain_obj));
 
-            auto bytes =
-                serialize_call<R, Args...>(std::move(func_name), std::forward<Args>(args)...);
+            // Only the final call is answered, the client completes it like a batch of one
+            std::vector<typename Serial::serial_t> responses{};
+            responses.push_back(run_chain(requests));
+            return Serial::make_batch(call_id, std::move(responses));
+        }
 
-            try
+        typename Serial::serial_t run_chain(
+            std::vector<std::optional<typename Serial::serial_t>>& requests) const
+        {
+            // Each call in a chain is sent as its links, followed by the call itself
+            if (requests.empty() || requests.size() % 2 != 0)
             {
-                send(std::move(bytes));
+                return make_error(server_receive_error("Invalid RPC object received"));
             }
-            catch (const std::exception& ex)
+
+            for (const auto& request : requests)
             {
-                throw client_send_error(ex.what());
+                if (!request.has_value())
+                {
+                    return make_error(server_receive_error("Invalid RPC object received"));
+                }
             }
 
+            const size_t step_count = requests.size() / 2;
+            auto& final_obj = requests.back().value();
+            chain_state state{ std::vector<std::any>(step_count), std::vector<size_t>(step_count) };
+            std::vector<std::vector<uint64_t>> links{};
+            links.reserve(step_count);
+
             try
             {
-                bytes = receive();
+                for (size_t i = 0; i < step_count; ++i)
+                {
+                    links.push_back(read_chain_links(requests[i * 2].value(), i));
+
+                    for (size_t j = 2; j < links.back().size(); j += 2)
+                    {
+                        ++state.uses[links.back()[j]];
+                    }
+                }
+
+                for (size_t i = 0; i < step_count; ++i)
+                {
+                    auto& step_obj = requests[i * 2 + 1].value();
+                    const auto func_name = adapter_t::get_func_name(step_obj);
+                    const auto it = m_chain_table.find(func_name);
+
+                    if (it == m_chain_table.end())
+                    {
+                        throw function_not_found(
+                            "RPC error: Called function: \"" + func_name + "\" not found");
+                    }
+
+                    state.results[i] = it->second(step_obj, links[i], state, i + 1 == step_count);
+                }
             }
-            catch (const std::exception& ex)
+            catch (const rpc_exception& ex)
             {
-                throw client_receive_error(ex.what());
+                Serial::set_exception(final_obj, ex);
             }
 
-            const auto pack = deserialize_call<R, Args...>(std::move(bytes));
-
-            // Assign values back to any (non-const) reference members
-            detail::tuple_bind(pack.get_args(), std::forward<Args>(args)...);
-            return pack.get_result();
+            return std::move(final_obj);
         }
 
-        ///@brief Sends an RPC call request to a server, waits for a response, then returns the result
-        ///
-        ///@tparam R Return type of the remote function to call
-        ///@tparam Args Variadic argument type(s) of the remote function to call
-        ///@param func Pointer to the function definition to deduce signature
-        ///@param func_name Name of the remote function to call
-        ///@param args Argument(s) for the remote function
-        ///@return R Result of the function call, will throw with server's error message if the result does not exist
-        ///@note nodiscard because an expensive remote procedure call is being performed
-        template<typename R, typename... Args>
-        [[nodiscard]] R call_header_func_impl(
-            [[maybe_unused]] R (*func)(Args...), std::string func_name, Args&&... args)
+        static std::vector<uint64_t> read_chain_links(
+            const typename Serial::serial_t& links_obj, const size_t step)
         {
-            RPC_HPP_PRECONDITION(!func_name.empty());
-
-            return call_func<R, Args...>(std::move(func_name), std::forward<Args>(args)...);
-        }
-
-    protected:
-        client_interface(client_interface&&) noexcept = default;
-
-        ///@brief Sends serialized data to a server or module
-        ///
-        ///@param bytes Serialized data to be sent
-        virtual void send(const typename Serial::bytes_t& bytes) = 0;
-
-        ///@brief Receives serialized data from a server or module
-        ///
-        ///@return Serial::bytes_t Received serialized data
-        virtual typename Serial::bytes_t receive() = 0;
+            auto links = std::get<0>(
+                read_pack<void, std::vector<uint64_t>>(links_obj).get_args());
 
-    private:
-        template<typename R, typename... Args>
-        static RPC_HPP_INLINE typename Serial::bytes_t serialize_call(
-            std::string func_name, Args&&... args)
-        {
-            detail::packed_func<R, detail::decay_str_t<Args>...> pack = [&]() noexcept
+            // Links are the mode, then pairs of argument index and source call index
+            if (links.empty() || links[0] > chain_map_mode || links.size() % 2 == 0)
             {
-                if constexpr (std::is_void_v<R>)
-                {
-                    return detail::packed_func<void, detail::decay_str_t<Args>...>{
-                        std::move(func_name), std::forward_as_tuple(args...)
-                    };
-                }
-                else
-                {
-                    return detail::packed_func<R, detail::decay_str_t<Args>...>{
-                        std::move(func_name), std::nullopt, std::forward_as_tuple(args...)
-                    };
-                }
-            }();
+                throw server_receive_error("Invalid chain links received");
+            }
 
-            auto serial_obj = [&pack]
+            for (size_t i = 2; i < links.size(); i += 2)
             {
-                try
-                {
-                    return Serial::serialize_pack(pack);
-                }
-                catch (const rpc_exception&)
-                {
-                    throw;
-                }
-                catch (const std::exception& ex)
+                if (links[i] >= step)
                 {
-                    throw serialization_error(ex.what());
+                    throw server_receive_error("Chained calls may only use earlier results");
                 }
-            }();
+            }
 
-            return Serial::to_bytes(std::move(serial_obj));
+            return links;
         }
 
         template<typename R, typename... Args>
-        static RPC_HPP_INLINE auto deserialize_call(typename Serial::bytes_t&& bytes)
+        static detail::packed_func<R, Args...> read_pack(
+            const typename Serial::serial_t& serial_obj)
         {
-            const auto ret_obj = Serial::from_bytes(std::move(bytes));
-
-            if (!ret_obj.has_value())
-            {
-                throw client_receive_error("Client received invalid RPC object");
-            }
-
             try
             {
-                return Serial::template deserialize_pack<R, detail::decay_str_t<Args>...>(
-                    ret_obj.value());
+                return Serial::template deserialize_request<R, Args...>(serial_obj);
             }
             catch (const rpc_exception&)
             {
@@ -1118,6 +1778,2044 @@ inline namespace client
                 throw deserialization_error(ex.what());
             }
         }
+
+        template<typename R, typename... Args, typename F>
+        static chain_callback_t make_chain_callback(F func)
+        {
+            return [func](typename Serial::serial_t& step_obj, const std::vector<uint64_t>& links,
+                       chain_state& state, const bool is_last)
+            {
+                if (links[0] == chain_map_mode)
+                {
+                    return run_chain_map<R, Args...>(func, step_obj, links, state, is_last);
+                }
+
+                return run_chain_call<R, Args...>(func, step_obj, links, state, is_last);
+            };
+        }
+
+        template<typename R, typename... Args, typename F>
+        static std::any run_chain_call(const F& func, typename Serial::serial_t& step_obj,
+            const std::vector<uint64_t>& links, chain_state& state, const bool is_last)
+        {
+            auto pack = read_pack<R, Args...>(step_obj);
+
+            for (size_t i = 1; i < links.size(); i += 2)
+            {
+                bind_chain_arg(pack.get_args(), std::index_sequence_for<Args...>{}, links[i],
+                    state, links[i + 1]);
+            }
+
+            if constexpr (std::is_void_v<R>)
+            {
+                invoke_chain<Args...>(func, pack.get_args());
+
+                if (is_last)
+                {
+                    step_obj = serialize_response(pack);
+                }
+
+                return {};
+            }
+            else
+            {
+                auto result = invoke_chain<Args...>(func, pack.get_args());
+
+                if (!is_last)
+                {
+                    return std::any{ std::move(result) };
+                }
+
+                pack.set_result(std::move(result));
+                step_obj = serialize_response(pack);
+                return {};
+            }
+        }
+
+        template<typename R, typename... Args, typename F>
+        static std::any run_chain_map(const F& func, typename Serial::serial_t& step_obj,
+            const std::vector<uint64_t>& links, chain_state& state, const bool is_last)
+        {
+            if constexpr (sizeof...(Args) != 1 || std::is_void_v<R>)
+            {
+                throw function_mismatch(
+                    "Only functions taking one argument and returning a value can be mapped");
+            }
+            else
+            {
+                using arg_t = std::remove_cv_t<
+                    std::remove_reference_t<std::tuple_element_t<0, std::tuple<Args...>>>>;
+
+                // A mapped call is sent with the element type as its argument
+                auto pack = read_pack<std::vector<R>, Args...>(step_obj);
+
+                if (links.size() != 3 || links[1] != 0)
+                {
+                    throw server_receive_error("Invalid chain links received");
+                }
+
+                const auto source = links[2];
+                const auto* const values =
+                    std::any_cast<std::vector<arg_t>>(&state.results[source]);
+
+                if (values == nullptr)
+                {
+                    throw function_mismatch("Chained result type does not match the argument type");
+                }
+
+                std::vector<R> results{};
+                results.reserve(values->size());
+
+                for (const auto& value : *values)
+                {
+                    auto arg = std::forward_as_tuple(value);
+                    results.push_back(invoke_chain<const arg_t&>(func, arg));
+                }
+
+                if (--state.uses[source] == 0)
+                {
+                    state.results[source].reset();
+                }
+
+                if (!is_last)
+                {
+                    return std::any{ std::move(results) };
+                }
+
+                pack.set_result(std::move(results));
+                step_obj = serialize_response(pack);
+                return {};
+            }
+        }
+
+        template<typename... Args, typename F, typename Tuple>
+        static decltype(auto) invoke_chain(const F& func, Tuple& args)
+        {
+            try
+            {
+                return detail::apply_args<Args...>(func, args);
+            }
+            catch (const std::exception& ex)
+            {
+                throw remote_exec_error(ex.what());
+            }
+        }
+
+        template<typename... Ts, size_t... Is>
+        static void bind_chain_arg(std::tuple<Ts...>& args,
+            [[maybe_unused]] std::index_sequence<Is...> iseq, const uint64_t arg_index,
+            chain_state& state, const size_t source)
+        {
+            // The last call to use a result may take it, the others get a copy
+            [[maybe_unused]] const bool last_use = --state.uses[source] == 0;
+
+            const bool bound = ((Is == arg_index
+                                    && (take_chain_result(std::get<Is>(args),
+                                            state.results[source], last_use),
+                                        true))
+                || ...);
+
+            if (!bound)
+            {
+                throw function_mismatch("Chained argument index is out of range");
+            }
+        }
+
+        template<typename T>
+        static void take_chain_result(T& arg, std::any& result, const bool last_use)
+        {
+            auto* const value = std::any_cast<T>(&result);
+
+            if (value == nullptr)
+            {
+                throw function_mismatch("Chained result type does not match the argument type");
+            }
+
+            if (last_use)
+            {
+                arg = std::move(*value);
+            }
+            else
+            {
+                arg = *value;
+            }
+        }
+
+        // Fewest calls worth handing to a worker, smaller batches and maps are run in order
+        static constexpr size_t min_calls_per_job = 16;
+
+        template<typename F>
+        std::vector<typename Serial::serial_t> run_calls(
+            std::vector<std::optional<typename Serial::serial_t>>& requests, const F& func) const
+        {
+            std::vector<typename Serial::serial_t> responses{};
+
+            const size_t job_count = (m_workers == nullptr)
+                ? 1
+                : std::min(m_workers->size(), requests.size() / min_calls_per_job);
+
+            if (job_count <= 1)
+            {
+                responses.reserve(requests.size());
+
+                for (auto& request : requests)
+                {
+                    responses.push_back(func(std::move(request)));
+                }
+
+                return responses;
+            }
+
+            responses.resize(requests.size());
+
+            // Each job runs a contiguous run of calls, so scheduling is paid once per job
+            const auto run_range = [&func, &requests, &responses](const size_t begin,
+                                       const size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                {
+                    responses[i] = func(std::move(requests[i]));
+                }
+            };
+
+            const auto job_begin = [&requests, job_count](const size_t job)
+            { return requests.size() * job / job_count; };
+
+            std::vector<std::future<void>> jobs{};
+            jobs.reserve(job_count - 1);
+
+            for (size_t job = 1; job < job_count; ++job)
+            {
+                jobs.push_back(m_workers->submit([&run_range, begin = job_begin(job),
+                                                     end = job_begin(job + 1)]
+                    { run_range(begin, end); }));
+            }
+
+            // The first run is done on this thread while the workers do the rest
+            std::exception_ptr error{};
+
+            try
+            {
+                run_range(0, job_begin(1));
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+
+            // Every job refers to the local vectors, so all must finish before any error is thrown
+            for (auto& job : jobs)
+            {
+                job.wait();
+            }
+
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+
+            for (auto& job : jobs)
+            {
+                job.get();
+            }
+
+            return responses;
+        }
+
+#  if defined(RPC_HPP_HAS_COROUTINES)
+        using co_callback_t = std::function<task<void>(typename Serial::serial_t&)>;
+
+        template<typename R, typename... Args>
+        static task<void> dispatch_coroutine(
+            task<R> (*func)(Args...), typename Serial::serial_t& serial_obj)
+        {
+            RPC_HPP_PRECONDITION(func != nullptr);
+
+            try
+            {
+                auto pack = [&serial_obj]
+                {
+                    try
+                    {
+                        return Serial::template deserialize_request<R, Args...>(serial_obj);
+                    }
+                    catch (const rpc_exception&)
+                    {
+                        throw;
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        throw deserialization_error(ex.what());
+                    }
+                }();
+
+                std::exception_ptr exec_error{};
+
+                // Translated outside of the handler, as co_await is not allowed in a catch block
+                try
+                {
+                    if constexpr (std::is_void_v<R>)
+                    {
+                        co_await detail::apply_args<Args...>(func, pack.get_args());
+                    }
+                    else
+                    {
+                        pack.set_result(
+                            co_await detail::apply_args<Args...>(func, pack.get_args()));
+                    }
+                }
+                catch (...)
+                {
+                    exec_error = std::current_exception();
+                }
+
+                if (exec_error)
+                {
+                    try
+                    {
+                        std::rethrow_exception(exec_error);
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        throw remote_exec_error(ex.what());
+                    }
+                }
+
+                // One-way calls are never answered, so the result is not serialized
+                if (pack.get_call_id() == detail::oneway_call_id)
+                {
+                    co_return;
+                }
+
+                serial_obj = serialize_response(pack);
+            }
+            catch (const rpc_exception& ex)
+            {
+                Serial::set_exception(serial_obj, ex);
+            }
+        }
+
+        static detail::detached_task run_coroutine(const co_callback_t& callback,
+            typename Serial::serial_t serial_obj,
+            std::function<void(typename Serial::bytes_t&&)> on_done)
+        {
+            co_await callback(serial_obj);
+            on_done(make_response(std::move(serial_obj)));
+        }
+#  endif
+
+        // Responses only carry back the arguments the callback may have changed
+        template<typename R, typename... Args>
+        static typename Serial::serial_t serialize_response(detail::packed_func<R, Args...>& pack)
+        {
+            pack.set_arg_mask(detail::output_arg_mask<Args...>());
+
+            try
+            {
+                return Serial::template serialize_response<R, Args...>(pack);
+            }
+            catch (const rpc_exception&)
+            {
+                throw;
+            }
+            catch (const std::exception& ex)
+            {
+                throw serialization_error(ex.what());
+            }
+        }
+
+        template<typename R, typename... Args>
+        static void run_callback(R (*func)(Args...), detail::packed_func<R, Args...>& pack)
+        {
+            RPC_HPP_PRECONDITION(func != nullptr);
+
+            auto& args = pack.get_args();
+
+            if constexpr (std::is_void_v<R>)
+            {
+                try
+                {
+                    detail::apply_args<Args...>(func, args);
+                }
+                catch (const std::exception& ex)
+                {
+                    throw remote_exec_error(ex.what());
+                }
+            }
+            else
+            {
+                try
+                {
+                    auto result = detail::apply_args<Args...>(func, args);
+                    pack.set_result(std::move(result));
+                }
+                catch (const std::exception& ex)
+                {
+                    throw remote_exec_error(ex.what());
+                }
+            }
+        }
+
+#  if defined(RPC_HPP_SERVER_IMPL) && defined(RPC_HPP_ENABLE_SERVER_CACHE)
+        // Cached results are keyed by the request without its call ID, which differs every call
+        template<typename R, typename... Args>
+        static typename Serial::bytes_t make_cache_key(const detail::packed_func<R, Args...>& pack)
+        {
+            if constexpr (std::is_void_v<R>)
+            {
+                return {};
+            }
+            else
+            {
+                const detail::request_view<Args...> request{ 0, pack.get_func_name(),
+                    pack.get_args() };
+
+                try
+                {
+                    return Serial::to_bytes(Serial::template serialize_request<R>(request));
+                }
+                catch (const rpc_exception&)
+                {
+                    throw;
+                }
+                catch (const std::exception& ex)
+                {
+                    throw serialization_error(ex.what());
+                }
+            }
+        }
+
+        // Caller must hold m_cache_mtx
+        template<typename Val>
+        std::shared_ptr<std::unordered_map<typename Serial::bytes_t, Val>> get_func_cache_impl(
+            const std::string& func_name)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            using cache_t = std::unordered_map<typename Serial::bytes_t, Val>;
+            auto& cache = m_cache_map[func_name];
+
+            if (cache == nullptr)
+            {
+                cache = std::make_shared<cache_t>();
+            }
+
+            return std::static_pointer_cast<cache_t>(cache);
+        }
+
+        // Each server has its own caches, so unrelated servers do not contend for the lock
+        std::unique_ptr<std::mutex> m_cache_mtx{ std::make_unique<std::mutex>() };
+        std::unordered_map<std::string, std::shared_ptr<void>> m_cache_map{};
+#  endif
+
+        std::unordered_map<std::string, callback_t> m_dispatch_table{};
+        std::unordered_map<std::string, chain_callback_t> m_chain_table{};
+
+        std::unique_ptr<detail::thread_pool> m_workers{};
+
+#  if defined(RPC_HPP_HAS_COROUTINES)
+        std::unordered_map<std::string, co_callback_t> m_co_dispatch_table{};
+#  endif
+    };
+} // namespace server
+#endif
+
+#if defined(RPC_HPP_CLIENT_IMPL)
+#  define call_header_func(FUNCNAME, ...) call_header_func_impl(FUNCNAME, #  FUNCNAME, __VA_ARGS__)
+
+///@brief Namespace containing functions and classes only relevant to "client-side" implentations
+///
+///@note Is only compiled by defining @ref RPC_HPP_CLIENT_IMPL
+inline namespace client
+{
+    template<typename Serial>
+    class client_interface;
+
+    ///@brief Handle to an RPC call that has been sent, but whose response has not been claimed yet
+    ///
+    ///@tparam Serial serial_adapter type that controls how objects are serialized/deserialized
+    ///@tparam R Return type of the remote function
+    ///@tparam Args Variadic argument type(s) of the remote function
+    template<typename Serial, typename R, typename... Args>
+    class pending_call
+    {
+    public:
+        ~pending_call() noexcept
+        {
+            if (m_client != nullptr)
+            {
+                m_client->discard_response(m_call_id);
+            }
+        }
+
+        // Prevent copying
+        pending_call(const pending_call&) = delete;
+        pending_call& operator=(const pending_call&) = delete;
+
+        pending_call(pending_call&& other) noexcept
+            : m_client(std::exchange(other.m_client, nullptr)),
+              m_call_id(other.m_call_id),
+              m_args(std::move(other.m_args))
+        {
+        }
+
+        // Assigning would write through any reference arguments
+        pending_call& operator=(pending_call&&) = delete;
+
+        ///@brief Gets the ID that correlates the request with its response
+        uint64_t get_call_id() const noexcept { return m_call_id; }
+
+        ///@brief Waits for the response to the call, then returns the result
+        ///
+        ///@return R Result of the function call, will throw with server's error message if the result does not exist
+        ///@throws client_receive_error Thrown if error occurs during the @ref client_interface::receive function
+        ///@note Responses to other pending calls received while waiting are held by the client until claimed
+        ///@note nodiscard because the response is consumed
+        [[nodiscard]] R get()
+        {
+            RPC_HPP_PRECONDITION(m_client != nullptr);
+
+            auto* const client = std::exchange(m_client, nullptr);
+            auto pack = client->template await_response<R, Args...>(m_call_id);
+
+            // Move values back to any (non-const) reference members
+            std::apply(
+                [&pack](auto&&... args) {
+                    detail::tuple_bind(std::move(pack.get_args()), pack.get_arg_mask(),
+                        std::forward<decltype(args)>(args)...);
+                },
+                std::move(m_args));
+
+            return std::move(pack).get_result();
+        }
+
+    private:
+        friend class client_interface<Serial>;
+
+        pending_call(client_interface<Serial>& client, const uint64_t call_id, Args&&... args)
+            : m_client(&client), m_call_id(call_id), m_args(std::forward<Args>(args)...)
+        {
+        }
+
+        client_interface<Serial>* m_client;
+        uint64_t m_call_id;
+        std::tuple<Args...> m_args;
+    };
+
+    ///@brief Handle to a remote function whose request envelope is built once, then completed
+    /// with the call ID and arguments of each call made through it
+    ///
+    ///@tparam Serial serial_adapter type that controls how objects are serialized/deserialized
+    ///@tparam R Return type of the remote function
+    ///@tparam Args Argument type(s) of the remote function, as declared in its signature
+    ///@note The handle refers to the client that prepared it, and must not outlive it
+    template<typename Serial, typename R, typename... Args>
+    class prepared_call
+    {
+    public:
+        ///@brief Gets the name of the remote function
+        const std::string& get_func_name() const noexcept { return m_func_name; }
+
+        ///@brief Sends an RPC call request to a server, waits for a response, then returns the
+        /// result
+        ///
+        ///@param args Argument(s) for the remote function
+        ///@return R Result of the function call, will throw with server's error message if the result does not exist
+        ///@throws client_send_error Thrown if error occurs during the @ref client_interface::send function
+        ///@throws client_receive_error Thrown if error occurs during the @ref client_interface::receive function
+        ///@note nodiscard because an expensive remote procedure call is being performed
+        [[nodiscard]] R operator()(detail::prepared_arg_t<Args>... args) const
+        {
+            const auto call_id = m_client->m_next_call_id++;
+            const detail::request_view<Args...> request{ call_id, m_func_name, { args... } };
+
+            m_client->send_request(
+                client_interface<Serial>::serialize_prepared_call(m_prepared, request));
+
+            auto pack = m_client->template await_response<R, Args...>(call_id);
+
+            // Move values back to any (non-const) reference members
+            detail::tuple_bind(std::move(pack.get_args()), pack.get_arg_mask(), args...);
+            return std::move(pack).get_result();
+        }
+
+    private:
+        friend class client_interface<Serial>;
+
+        prepared_call(client_interface<Serial>& client, std::string&& func_name)
+            : m_client(&client),
+              m_func_name(std::move(func_name)),
+              m_prepared(client_interface<Serial>::template prepare_call<R, Args...>(m_func_name))
+        {
+        }
+
+        client_interface<Serial>* m_client;
+        std::string m_func_name;
+        typename Serial::serial_t m_prepared;
+    };
+
+#  if defined(RPC_HPP_HAS_COROUTINES)
+    ///@brief Awaitable RPC call, sent when first awaited
+    ///
+    ///@tparam Serial serial_adapter type that controls how objects are serialized/deserialized
+    ///@tparam R Return type of the remote function
+    ///@tparam Args Variadic argument type(s) of the remote function
+    template<typename Serial, typename R, typename... Args>
+    class call_awaitable
+    {
+    public:
+        // Prevent copying and moving, the transport may refer to the awaitable until it is resumed
+        call_awaitable(const call_awaitable&) = delete;
+        call_awaitable(call_awaitable&&) = delete;
+        call_awaitable& operator=(const call_awaitable&) = delete;
+        call_awaitable& operator=(call_awaitable&&) = delete;
+        ~call_awaitable() noexcept = default;
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(const std::coroutine_handle<> handle)
+        {
+            m_handle = handle;
+
+            m_client.start_async(m_call_id, std::move(m_bytes),
+                [this](typename Serial::serial_t&& serial_obj, const std::exception_ptr& error)
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<R>)
+                        {
+                            client_interface<Serial>::template complete_call<R, Args...>(
+                                serial_obj, error, m_args);
+                        }
+                        else
+                        {
+                            m_result.emplace(
+                                client_interface<Serial>::template complete_call<R, Args...>(
+                                    serial_obj, error, m_args));
+                        }
+                    }
+                    catch (...)
+                    {
+                        m_error = std::current_exception();
+                    }
+
+                    // Only resume if the awaiting coroutine has already been suspended
+                    if (m_completed.exchange(true))
+                    {
+                        m_handle.resume();
+                    }
+                });
+
+            // The call may have completed inline, in which case the coroutine continues directly
+            return !m_completed.exchange(true);
+        }
+
+        R await_resume()
+        {
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+
+            if constexpr (!std::is_void_v<R>)
+            {
+                return std::move(m_result).value();
+            }
+        }
+
+    private:
+        friend class client_interface<Serial>;
+
+        call_awaitable(client_interface<Serial>& client, const uint64_t call_id,
+            typename Serial::bytes_t&& bytes, Args&&... args)
+            : m_client(client),
+              m_call_id(call_id),
+              m_bytes(std::move(bytes)),
+              m_args(std::forward<Args>(args)...)
+        {
+        }
+
+        client_interface<Serial>& m_client;
+        uint64_t m_call_id;
+        typename Serial::bytes_t m_bytes;
+        std::tuple<Args...> m_args;
+        std::coroutine_handle<> m_handle{};
+        std::optional<std::conditional_t<std::is_void_v<R>, bool, R>> m_result{};
+        std::exception_ptr m_error{};
+        std::atomic<bool> m_completed{ false };
+    };
+#  endif
+
+    ///@brief Call to be sent as part of a batch, see @ref client_interface::call_batch
+    ///
+    ///@tparam R Return type of the remote function
+    ///@tparam Args Variadic argument type(s) of the remote function
+    template<typename R, typename... Args>
+    class batched_call
+    {
+    public:
+        using result_t = R;
+
+        batched_call(std::string func_name, Args&&... args)
+            : m_func_name(std::move(func_name)), m_args(std::forward<Args>(args)...)
+        {
+            RPC_HPP_PRECONDITION(!m_func_name.empty());
+        }
+
+    private:
+        template<typename>
+        friend class client_interface;
+
+        std::string m_func_name;
+        std::tuple<Args...> m_args;
+    };
+
+    ///@brief Creates a call to be sent as part of a batch, see @ref client_interface::call_batch
+    ///
+    ///@tparam R Return type of the remote function to call
+    ///@tparam Args Variadic argument type(s) of the remote function to call
+    ///@param func_name Name of the remote function to call
+    ///@param args Argument(s) for the remote function
+    ///@return batched_call<R, Args...> Call to pass to @ref client_interface::call_batch
+    ///@note Reference arguments must outlive the batch
+    template<typename R = void, typename... Args>
+    [[nodiscard]] batched_call<R, Args...> batch_call(std::string func_name, Args&&... args)
+    {
+        return batched_call<R, Args...>{ std::move(func_name), std::forward<Args>(args)... };
+    }
+
+    ///@brief Placeholder for the result of an earlier call in a chain, see
+    /// @ref client_interface::call_chain
+    ///
+    ///@tparam Step Index of the call in the chain whose result is passed
+    template<size_t Step>
+    struct chain_ref
+    {
+        static constexpr size_t step = Step;
+    };
+
+    template<typename T>
+    struct is_chain_ref : std::false_type
+    {
+    };
+
+    template<size_t Step>
+    struct is_chain_ref<chain_ref<Step>> : std::true_type
+    {
+    };
+
+    template<typename T>
+    inline constexpr bool is_chain_ref_v = is_chain_ref<T>::value;
+
+    ///@brief Call to be sent as part of a chain, see @ref client_interface::call_chain
+    ///
+    ///@tparam R Return type of the remote function
+    ///@tparam IsMap Whether the remote function is applied to each element of an earlier result
+    ///@tparam Args Variadic argument type(s) of the remote function, or @ref chain_ref
+    template<typename R, bool IsMap, typename... Args>
+    class chained_call
+    {
+    public:
+        using result_t = std::conditional_t<IsMap, std::vector<R>, R>;
+
+        chained_call(std::string func_name, Args&&... args)
+            : m_func_name(std::move(func_name)), m_args(std::forward<Args>(args)...)
+        {
+            RPC_HPP_PRECONDITION(!m_func_name.empty());
+        }
+
+    private:
+        template<typename>
+        friend class client_interface;
+
+        std::string m_func_name;
+        std::tuple<Args...> m_args;
+    };
+
+    ///@brief Creates a call to be sent as part of a chain, see @ref client_interface::call_chain
+    ///
+    ///@tparam R Return type of the remote function to call
+    ///@tparam Args Variadic argument type(s) of the remote function to call
+    ///@param func_name Name of the remote function to call
+    ///@param args Argument(s) for the remote function, a @ref chain_ref passes an earlier result
+    ///@return chained_call<R, false, Args...> Call to pass to @ref client_interface::call_chain
+    template<typename R = void, typename... Args>
+    [[nodiscard]] chained_call<R, false, Args...> chain_call(std::string func_name, Args&&... args)
+    {
+        return chained_call<R, false, Args...>{ std::move(func_name), std::forward<Args>(args)... };
+    }
+
+    ///@brief Creates a call to be sent as part of a chain that applies a remote function to each
+    /// element of an earlier result, see @ref client_interface::call_chain
+    ///
+    ///@tparam R Return type of the remote function to call
+    ///@tparam Step Index of the earlier call, whose result must be a std::vector
+    ///@param func_name Name of the remote function to call, taking a single argument
+    ///@param source Placeholder for the earlier result
+    ///@return chained_call<R, true, chain_ref<Step>> Call whose result is a std::vector<R>
+    template<typename R, size_t Step>
+    [[nodiscard]] chained_call<R, true, chain_ref<Step>> chain_map(
+        std::string func_name, chain_ref<Step> source)
+    {
+        return chained_call<R, true, chain_ref<Step>>{ std::move(func_name), std::move(source) };
+    }
+
+    ///@brief Result of a call made in a batch, holding either the returned value or the error
+    ///
+    ///@tparam R Return type of the remote function
+    template<typename R>
+    class call_result
+    {
+    public:
+        explicit operator bool() const noexcept { return !m_error; }
+
+        ///@brief Gets the returned value, rethrowing the error if the call failed
+        const R& get() const&
+        {
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+
+            return m_value.value();
+        }
+
+        ///@brief Gets the returned value, rethrowing the error if the call failed
+        R get() &&
+        {
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+
+            return std::move(m_value).value();
+        }
+
+        const std::exception_ptr& get_error() const noexcept { return m_error; }
+
+    private:
+        template<typename>
+        friend class client_interface;
+
+        std::optional<R> m_value{};
+        std::exception_ptr m_error{};
+    };
+
+    template<>
+    class call_result<void>
+    {
+    public:
+        explicit operator bool() const noexcept { return !m_error; }
+
+        ///@brief Rethrows the error if the call failed
+        void get() const
+        {
+            if (m_error)
+            {
+                std::rethrow_exception(m_error);
+            }
+        }
+
+        const std::exception_ptr& get_error() const noexcept { return m_error; }
+
+    private:
+        template<typename>
+        friend class client_interface;
+
+        std::exception_ptr m_error{};
+    };
+
+    ///@brief Class defining an interface for calling into an RPC server or module
+    ///
+    ///@tparam Serial serial_adapter type that controls how objects are serialized/deserialized
+    template<typename Serial>
+    class client_interface
+    {
+    public:
+        virtual ~client_interface() noexcept = default;
+        client_interface() = default;
+
+        // Prevent copying
+        client_interface(const client_interface&) = delete;
+        client_interface& operator=(const client_interface&) = delete;
+
+        // Prevent slicing
+        client_interface& operator=(client_interface&&) = delete;
+
+        ///@brief Sends an RPC call request to a server, waits for a response, then returns the result
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param func_name Name of the remote function to call
+        ///@param args Argument(s) for the remote function
+        ///@return R Result of the function call, will throw with server's error message if the result does not exist
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@throws client_receive_error Thrown if error occurs during the @ref receive function
+        ///@note nodiscard because an expensive remote procedure call is being performed
+        template<typename R = void, typename... Args>
+        [[nodiscard]] R call_func(std::string func_name, Args&&... args)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            const auto call_id = m_next_call_id++;
+
+            send_request(serialize_call<R, Args...>(
+                call_id, func_name, std::forward<Args>(args)...));
+
+            auto pack = await_response<R, Args...>(call_id);
+
+            // Move values back to any (non-const) reference members
+            detail::tuple_bind(
+                std::move(pack.get_args()), pack.get_arg_mask(), std::forward<Args>(args)...);
+
+            return std::move(pack).get_result();
+        }
+
+        ///@brief Sends an RPC call request to a server, waits for a response, then reads the result
+        /// into an existing object
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param out Object the result is read into, strings and containers reuse their storage
+        ///@param func_name Name of the remote function to call
+        ///@param args Argument(s) for the remote function
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@throws client_receive_error Thrown if error occurs during the @ref receive function
+        ///@note @p out is left in a valid, but unspecified state if an exception is thrown
+        template<typename R, typename... Args>
+        void call_func_into(R& out, std::string func_name, Args&&... args)
+        {
+            static_assert(!std::is_const_v<R>, "The result cannot be read into a const object");
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            const auto call_id = m_next_call_id++;
+
+            send_request(serialize_call<R, Args...>(
+                call_id, func_name, std::forward<Args>(args)...));
+
+            auto pack = deserialize_call_into<R, Args...>(receive_response(call_id), out);
+
+            // Move values back to any (non-const) reference members
+            detail::tuple_bind(
+                std::move(pack.get_args()), pack.get_arg_mask(), std::forward<Args>(args)...);
+
+            // throws with the server's error message if the call failed
+            pack.get_result();
+        }
+
+        ///@brief Builds the request envelope for a remote function once, so that calls made through
+        /// the returned handle only serialize their call ID and arguments
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Argument type(s) of the remote function, as declared in its signature
+        ///@param func_name Name of the remote function to call
+        ///@return prepared_call<Serial, R, Args...> Handle used to make the calls
+        ///@note The returned handle must not outlive the client
+        ///@note nodiscard because the calls can only be made through the returned handle
+        template<typename R = void, typename... Args>
+        [[nodiscard]] prepared_call<Serial, R, Args...> prepare(std::string func_name)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            return prepared_call<Serial, R, Args...>{ *this, std::move(func_name) };
+        }
+
+        ///@brief Sends a one-way RPC call request to a server, which runs the function but never
+        /// sends a response
+        ///
+        ///@tparam R Return type of the remote function to call (the result is discarded)
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param func_name Name of the remote function to call
+        ///@param args Argument(s) for the remote function
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@note Errors raised by the remote function are not reported, and reference arguments
+        /// are not assigned back to
+        template<typename R = void, typename... Args>
+        void notify(std::string func_name, Args&&... args)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            send_request(serialize_call<R, Args...>(
+                detail::oneway_call_id, func_name, std::forward<Args>(args)...));
+        }
+
+        ///@brief Sends an RPC call request to a server without waiting for the response
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param func_name Name of the remote function to call
+        ///@param args Argument(s) for the remote function
+        ///@return pending_call<Serial, R, Args...> Handle used to wait for the result
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@note Many calls may be in flight at once, responses are matched by call ID in any order
+        ///@note Reference arguments must outlive the returned handle
+        ///@note nodiscard because the result can only be retrieved through the returned handle
+        template<typename R = void, typename... Args>
+        [[nodiscard]] pending_call<Serial, R, Args...> call_func_pipelined(
+            std::string func_name, Args&&... args)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            const auto call_id = m_next_call_id++;
+
+            send_request(serialize_call<R, Args...>(
+                call_id, func_name, std::forward<Args>(args)...));
+
+            return pending_call<Serial, R, Args...>{ *this, call_id, std::forward<Args>(args)... };
+        }
+
+        ///@brief Sends several RPC calls to a server in one message, waits for the combined
+        /// response, then returns the result of each call
+        ///
+        ///@tparam Calls Types of the calls in the batch (created by @ref batch_call)
+        ///@param calls Calls to send, run by the server in order
+        ///@return std::tuple<call_result<...>...> Result (or error) of each call, in order
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@throws client_receive_error Thrown if error occurs during the @ref receive function
+        ///@note An error in one call does not prevent the others from running
+        ///@note nodiscard because an expensive remote procedure call is being performed
+        template<typename... Calls>
+        [[nodiscard]] std::tuple<call_result<typename std::remove_reference_t<Calls>::result_t>...>
+            call_batch(Calls&&... calls)
+        {
+            std::vector<typename Serial::serial_t> requests{};
+            requests.reserve(sizeof...(Calls));
+            (requests.push_back(make_batch_request(calls)), ...);
+
+            auto responses = send_batch(std::move(requests));
+            return complete_batch(responses, std::index_sequence_for<Calls...>{}, calls...);
+        }
+
+        ///@brief Sends several RPC calls to the same function signature to a server in one
+        /// message, waits for the combined response, then returns the result of each call
+        ///
+        ///@tparam R Return type of the remote functions to call
+        ///@tparam Args Variadic argument type(s) of the remote functions to call
+        ///@param calls Calls to send (created by @ref batch_call), run by the server in order
+        ///@return std::vector<call_result<R>> Result (or error) of each call, in order
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@throws client_receive_error Thrown if error occurs during the @ref receive function
+        ///@note An error in one call does not prevent the others from running
+        ///@note nodiscard because an expensive remote procedure call is being performed
+        template<typename R, typename... Args>
+        [[nodiscard]] std::vector<call_result<R>> call_batch(
+            std::vector<batched_call<R, Args...>> calls)
+        {
+            std::vector<typename Serial::serial_t> requests{};
+            requests.reserve(calls.size());
+
+            for (auto& call : calls)
+            {
+                requests.push_back(make_batch_request(call));
+            }
+
+            auto responses = send_batch(std::move(requests));
+            std::vector<call_result<R>> results{};
+            results.reserve(calls.size());
+
+            for (size_t i = 0; i < calls.size(); ++i)
+            {
+                results.push_back(complete_batch_call(calls[i], std::move(responses[i])));
+            }
+
+            return results;
+        }
+
+        ///@brief Calls one remote function with each of several sets of arguments in one
+        /// message, waits for the combined response, then returns the result of each call
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param func_name Name of the remote function to call
+        ///@param arg_sets Argument(s) for each call of the remote function
+        ///@return std::vector<call_result<R>> Result (or error) of each call, in order
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@throws client_receive_error Thrown if error occurs during the @ref receive function
+        ///@note The function name is only sent (and looked up by the server) once
+        ///@note Reference arguments are not assigned back to, so arguments are passed by value
+        ///@note nodiscard because an expensive remote procedure call is being performed
+        template<typename R, typename... Args>
+        [[nodiscard]] std::vector<call_result<R>> call_map(
+            std::string func_name, const std::vector<std::tuple<Args...>>& arg_sets)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            if (arg_sets.empty())
+            {
+                return {};
+            }
+
+            std::vector<typename Serial::serial_t> requests{};
+            requests.reserve(arg_sets.size());
+
+            for (const auto& arg_set : arg_sets)
+            {
+                requests.push_back(std::apply(
+                    [](const Args&... args)
+                    { return make_request<R, const Args&...>(0, std::string{}, args...); },
+                    arg_set));
+            }
+
+            const auto call_id = m_next_call_id++;
+            auto responses = send_multi(call_id,
+                Serial::make_map(call_id, func_name, std::move(requests)), arg_sets.size());
+
+            std::vector<call_result<R>> results{};
+            results.reserve(arg_sets.size());
+
+            for (size_t i = 0; i < arg_sets.size(); ++i)
+            {
+                std::tuple<const Args&...> args = arg_sets[i];
+                results.push_back(complete_multi_call<R>(std::move(responses[i]), args));
+            }
+
+            return results;
+        }
+
+        ///@brief Sends several dependent RPC calls to a server in one message, which runs them in
+        /// order while passing results between them, then returns the result of the final call
+        ///
+        ///@tparam Calls Types of the calls in the chain (created by @ref chain_call or
+        /// @ref chain_map)
+        ///@param calls Calls to send, a @ref chain_ref argument is replaced by an earlier result
+        ///@return Result of the final call
+        ///@throws client_send_error Thrown if error occurs during the @ref send function
+        ///@throws client_receive_error Thrown if error occurs during the @ref receive function
+        ///@throws Any rpc_exception raised by a call in the chain (the rest are not run)
+        ///@note Intermediate results stay on the server, and must match the type of the argument
+        /// they are passed to exactly
+        ///@note Reference arguments are not assigned back to, and cached bindings are not cached
+        ///@note nodiscard because an expensive remote procedure call is being performed
+        template<typename... Calls>
+        [[nodiscard]] auto call_chain(Calls&&... calls)
+        {
+            static_assert(sizeof...(Calls) != 0, "A chain must contain at least one call");
+
+            using results_t = std::tuple<typename std::remove_reference_t<Calls>::result_t...>;
+
+            std::vector<typename Serial::serial_t> requests{};
+            requests.reserve(sizeof...(Calls) * 2);
+            add_chain_calls<results_t>(requests, std::index_sequence_for<Calls...>{}, calls...);
+
+            const auto call_id = m_next_call_id++;
+            auto responses =
+                send_multi(call_id, Serial::make_chain(call_id, std::move(requests)), 1);
+
+            if (!responses[0].has_value())
+            {
+                throw client_receive_error("Client received invalid RPC object");
+            }
+
+            return complete_chain<results_t>(responses[0].value(), std::get<sizeof...(Calls) - 1>(
+                std::forward_as_tuple(calls...)));
+        }
+
+        ///@brief Sends an RPC call request to a server, returning a future for the result
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param func_name Name of the remote function to call
+        ///@param args Argument(s) for the remote function
+        ///@return std::future<R> Future that receives the result, or the error from the call
+        ///@note Transport work is done through @ref async_send and @ref async_receive, so the call
+        /// only blocks if those do
+        ///@note Reference arguments are assigned before the future becomes ready, so they (and the
+        /// client) must outlive the call
+        ///@note nodiscard because the result can only be retrieved through the returned future
+        template<typename R = void, typename... Args>
+        [[nodiscard]] std::future<R> call_func_async(std::string func_name, Args&&... args)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            const auto call_id = m_next_call_id++;
+            auto bytes = serialize_call<R, Args...>(
+                call_id, func_name, std::forward<Args>(args)...);
+
+            const auto promise = std::make_shared<std::promise<R>>();
+            auto result = promise->get_future();
+
+            start_async(call_id, std::move(bytes),
+                [promise, bound_args = std::make_shared<std::tuple<Args...>>(
+                              std::forward<Args>(args)...)](
+                    typename Serial::serial_t&& serial_obj, const std::exception_ptr& error)
+                {
+                    try
+                    {
+                        if constexpr (std::is_void_v<R>)
+                        {
+                            complete_call<R, Args...>(serial_obj, error, *bound_args);
+                            promise->set_value();
+                        }
+                        else
+                        {
+                            promise->set_value(
+                                complete_call<R, Args...>(serial_obj, error, *bound_args));
+                        }
+                    }
+                    catch (...)
+                    {
+                        promise->set_exception(std::current_exception());
+                    }
+                });
+
+            return result;
+        }
+
+#  if defined(RPC_HPP_HAS_COROUTINES)
+        ///@brief Sends an RPC call request to a server, resuming the awaiting coroutine with the result
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param func_name Name of the remote function to call
+        ///@param args Argument(s) for the remote function
+        ///@return call_awaitable<Serial, R, Args...> Awaitable that sends the call once awaited
+        ///@note Transport work is done through @ref async_send and @ref async_receive, so the
+        /// awaiting coroutine may be resumed on the thread that completes the receive
+        ///@note nodiscard because the call is only sent once the result is awaited
+        template<typename R = void, typename... Args>
+        [[nodiscard]] call_awaitable<Serial, R, Args...> call_func_co(
+            std::string func_name, Args&&... args)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            const auto call_id = m_next_call_id++;
+            auto bytes = serialize_call<R, Args...>(
+                call_id, func_name, std::forward<Args>(args)...);
+
+            return call_awaitable<Serial, R, Args...>{ *this, call_id, std::move(bytes),
+                std::forward<Args>(args)... };
+        }
+#  endif
+
+        ///@brief Sends an RPC call request to a server, waits for a response, then returns the result
+        ///
+        ///@tparam R Return type of the remote function to call
+        ///@tparam Args Variadic argument type(s) of the remote function to call
+        ///@param func Pointer to the function definition to deduce signature
+        ///@param func_name Name of the remote function to call
+        ///@param args Argument(s) for the remote function
+        ///@return R Result of the function call, will throw with server's error message if the result does not exist
+        ///@note nodiscard because an expensive remote procedure call is being performed
+        template<typename R, typename... Args>
+        [[nodiscard]] R call_header_func_impl(
+            [[maybe_unused]] R (*func)(Args...), std::string func_name, Args&&... args)
+        {
+            RPC_HPP_PRECONDITION(!func_name.empty());
+
+            return call_func<R, Args...>(std::move(func_name), std::forward<Args>(args)...);
+        }
+
+    protected:
+        client_interface(client_interface&& other)
+        {
+            std::lock_guard<std::mutex> lock{ other.m_mtx };
+            m_next_call_id = other.m_next_call_id.load();
+            m_responses = std::move(other.m_responses);
+            m_discarded = std::move(other.m_discarded);
+            m_failed_through = other.m_failed_through;
+            m_stream_error = std::move(other.m_stream_error);
+            m_handlers = std::move(other.m_handlers);
+        }
+
+        ///@brief Gets the number of responses held for unclaimed calls, and of dropped calls whose
+        /// responses are still expected
+        ///
+        ///@return size_t Number of responses and call IDs held by the client
+        [[nodiscard]] size_t held_responses() const
+        {
+            std::lock_guard<std::mutex> lock{ m_mtx };
+            return m_responses.size() + m_discarded.size();
+        }
+
+        ///@brief Sends serialized data to a server or module
+        ///
+        ///@param bytes Serialized data to be sent
+        ///@note May be called from several threads at once (and alongside @ref async_send), each
+        /// message must be sent whole
+        virtual void send(const typename Serial::bytes_t& bytes) = 0;
+
+        ///@brief Receives serialized data from a server or module
+        ///
+        ///@return Serial::bytes_t Received serialized data
+        ///@note Never called while another receive (or @ref async_receive) is in progress
+        virtual typename Serial::bytes_t receive() = 0;
+
+        ///@brief Starts sending serialized data to a server or module
+        ///
+        ///@param bytes Serialized data to be sent
+        ///@param on_sent Handler to invoke once the data is sent, given the error (if any)
+        ///@note Default implementation calls @ref send and invokes the handler inline
+        virtual void async_send(typename Serial::bytes_t&& bytes,
+            std::function<void(const std::exception_ptr&)> on_sent)
+        {
+            try
+            {
+                send(bytes);
+            }
+            catch (...)
+            {
+                on_sent(std::current_exception());
+                return;
+            }
+
+            on_sent(nullptr);
+        }
+
+        ///@brief Starts receiving serialized data from a server or module
+        ///
+        ///@param on_received Handler to invoke with the received data, or the error (if any)
+        ///@note Default implementation calls @ref receive and invokes the handler inline
+        ///@note Only called while no other receive is in progress, and again after each completion
+        /// while calls sent with @ref call_func_async are outstanding. The received data may be
+        /// the response to any outstanding call
+        virtual void async_receive(
+            std::function<void(typename Serial::bytes_t&&, const std::exception_ptr&)> on_received)
+        {
+            // Callers that only wait for their own response leave receiving to the asynchronous
+            // callers from now on, as there is no other thread to do it
+            m_inline_receive = true;
+
+            auto bytes = [this, &on_received]() -> std::optional<typename Serial::bytes_t>
+            {
+                try
+                {
+                    return receive();
+                }
+                catch (...)
+                {
+                    on_received(typename Serial::bytes_t{}, std::current_exception());
+                    return std::nullopt;
+                }
+            }();
+
+            if (bytes.has_value())
+            {
+                on_received(std::move(bytes).value(), nullptr);
+            }
+        }
+
+    private:
+        using response_handler_t =
+            std::function<void(typename Serial::serial_t&&, const std::exception_ptr&)>;
+
+#  if defined(RPC_HPP_HAS_COROUTINES)
+        template<typename, typename, typename...>
+        friend class call_awaitable;
+#  endif
+
+        template<typename, typename, typename...>
+        friend class pending_call;
+
+        template<typename, typename, typename...>
+        friend class prepared_call;
+
+        template<typename R, typename... Args>
+        static typename Serial::serial_t prepare_call(const std::string& func_name)
+        {
+            try
+            {
+                return Serial::template prepare_request<R, Args...>(func_name);
+            }
+            catch (const rpc_exception&)
+            {
+                throw;
+            }
+            catch (const std::exception& ex)
+            {
+                throw serialization_error(ex.what());
+            }
+        }
+
+        template<typename... Args>
+        static typename Serial::bytes_t serialize_prepared_call(
+            const typename Serial::serial_t& prepared, const detail::request_view<Args...>& request)
+        {
+            try
+            {
+                return Serial::to_bytes(Serial::serialize_prepared(prepared, request));
+            }
+            catch (const rpc_exception&)
+            {
+                throw;
+            }
+            catch (const std::exception& ex)
+            {
+                throw serialization_error(ex.what());
+            }
+        }
+
+        template<typename R, typename... Args>
+        static RPC_HPP_INLINE typename Serial::bytes_t serialize_call(
+            const uint64_t call_id, const std::string& func_name, Args&&... args)
+        {
+            return Serial::to_bytes(
+                make_request<R, Args...>(call_id, func_name, std::forward<Args>(args)...));
+        }
+
+        template<typename R, typename... Args>
+        static typename Serial::serial_t make_request(
+            const uint64_t call_id, const std::string& func_name, Args&&... args)
+        {
+            // The arguments are serialized straight from the caller's objects
+            const std::tuple<detail::request_arg_t<Args>...> call_args{ args... };
+            const detail::request_view<detail::decay_str_t<Args>...> request{ call_id, func_name,
+                call_args };
+
+            try
+            {
+                return Serial::template serialize_request<R>(request);
+            }
+            catch (const rpc_exception&)
+            {
+                throw;
+            }
+            catch (const std::exception& ex)
+            {
+                throw serialization_error(ex.what());
+            }
+        }
+
+        template<typename R, typename... Args>
+        static RPC_HPP_INLINE auto deserialize_call(const typename Serial::serial_t& serial_obj)
+        {
+            try
+            {
+                return Serial::template deserialize_response<R, detail::decay_str_t<Args>...>(
+                    serial_obj);
+            }
+            catch (const rpc_exception&)
+            {
+                throw;
+            }
+            catch (const std::exception& ex)
+            {
+                throw deserialization_error(ex.what());
+            }
+        }
+
+        template<typename R, typename... Args>
+        static RPC_HPP_INLINE auto deserialize_call_into(
+            const typename Serial::serial_t& serial_obj, R& result)
+        {
+            try
+            {
+                return Serial::template deserialize_response_into<R,
+                    detail::decay_str_t<Args>...>(serial_obj, result);
+            }
+            catch (const rpc_exception&)
+            {
+                throw;
+            }
+            catch (const std::exception& ex)
+            {
+                throw deserialization_error(ex.what());
+            }
+        }
+
+        void send_request(typename Serial::bytes_t&& bytes)
+        {
+            try
+            {
+                send(std::move(bytes));
+            }
+            catch (const std::exception& ex)
+            {
+                throw client_send_error(ex.what());
+            }
+        }
+
+        template<typename R, typename... Args>
+        static R complete_call(const typename Serial::serial_t& serial_obj,
+            const std::exception_ptr& error, std::tuple<Args...>& args)
+        {
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+
+            auto pack = deserialize_call<R, Args...>(serial_obj);
+
+            // Move values back to any (non-const) reference members
+            std::apply(
+                [&pack](auto&&... call_args) {
+                    detail::tuple_bind(std::move(pack.get_args()), pack.get_arg_mask(),
+                        std::forward<decltype(call_args)>(call_args)...);
+                },
+                std::move(args));
+
+            return std::move(pack).get_result();
+        }
+
+        void start_async(
+            const uint64_t call_id, typename Serial::bytes_t&& bytes, response_handler_t&& handler)
+        {
+            add_handler(call_id, std::move(handler));
+
+            try
+            {
+                async_send(std::move(bytes),
+                    [this, call_id](const std::exception_ptr& send_error)
+                    {
+                        if (send_error)
+                        {
+                            fail_call(call_id, wrap_error<client_send_error>(send_error));
+                            return;
+                        }
+
+                        continue_async_receive();
+                    });
+            }
+            catch (...)
+            {
+                fail_call(call_id, wrap_error<client_send_error>(std::current_exception()));
+            }
+        }
+
+        template<typename R, typename... Args>
+        static typename Serial::serial_t make_batch_request(batched_call<R, Args...>& call)
+        {
+            return std::apply(
+                [&call](auto&&... args) {
+                    return make_request<R, Args...>(
+                        0, call.m_func_name, std::forward<Args>(args)...);
+                },
+                call.m_args);
+        }
+
+        std::vector<std::optional<typename Serial::serial_t>> send_batch(
+            std::vector<typename Serial::serial_t>&& requests)
+        {
+            const auto call_id = m_next_call_id++;
+            const auto call_count = requests.size();
+
+            return send_multi(
+                call_id, Serial::make_batch(call_id, std::move(requests)), call_count);
+        }
+
+        // Sends a batch or map of calls, returning the response to each call in order
+        std::vector<std::optional<typename Serial::serial_t>> send_multi(const uint64_t call_id,
+            typename Serial::serial_t&& request, const size_t call_count)
+        {
+            send_request(Serial::to_bytes(std::move(request)));
+            auto response = receive_response(call_id);
+
+            if (!Serial::is_batch(response) && !Serial::is_map(response))
+            {
+                // The request as a whole failed, throws with the server's error message
+                deserialize_call<void>(response).get_result();
+                throw client_receive_error("Client received invalid RPC object");
+            }
+
+            auto responses = Serial::is_batch(response) ? Serial::split_batch(std::move(response))
+                                                        : Serial::split_map(std::move(response));
+
+            // Any missing responses will fail their call
+            responses.resize(call_count);
+            return responses;
+        }
+
+        template<typename R, typename... Args>
+        static RPC_HPP_INLINE call_result<R> complete_batch_call(batched_call<R, Args...>& call,
+            std::optional<typename Serial::serial_t>&& response)
+        {
+            return complete_multi_call<R>(std::move(response), call.m_args);
+        }
+
+        template<typename R, typename... Args>
+        static call_result<R> complete_multi_call(
+            std::optional<typename Serial::serial_t>&& response, std::tuple<Args...>& args)
+        {
+            call_result<R> result{};
+
+            try
+            {
+                if (!response.has_value())
+                {
+                    throw client_receive_error("Client received invalid RPC object");
+                }
+
+                if constexpr (std::is_void_v<R>)
+                {
+                    complete_call<R, Args...>(response.value(), nullptr, args);
+                }
+                else
+                {
+                    result.m_value.emplace(
+                        complete_call<R, Args...>(response.value(), nullptr, args));
+                }
+            }
+            catch (...)
+            {
+                result.m_error = std::current_exception();
+            }
+
+            return result;
+        }
+
+        template<typename Results, typename... Calls, size_t... Is>
+        static void add_chain_calls(std::vector<typename Serial::serial_t>& requests,
+            [[maybe_unused]] std::index_sequence<Is...> iseq, Calls&... calls)
+        {
+            (add_chain_call<Results, Is>(requests, calls), ...);
+        }
+
+        template<typename Results, size_t Step, typename R, bool IsMap, typename... Args>
+        static void add_chain_call(std::vector<typename Serial::serial_t>& requests,
+            chained_call<R, IsMap, Args...>& call)
+        {
+            // Links are the mode, then pairs of argument index and source call index
+            std::vector<uint64_t> links{ IsMap ? 1U : 0U };
+            add_chain_links<Step>(links, std::index_sequence_for<Args...>{}, call.m_args);
+
+            requests.push_back(make_request<void>(0, call.m_func_name, std::move(links)));
+            requests.push_back(std::apply(
+                [&call](auto&... args)
+                {
+                    return make_request<typename chained_call<R, IsMap, Args...>::result_t>(
+                        0, call.m_func_name, resolve_chain_arg<Results, IsMap>(args)...);
+                },
+                call.m_args));
+        }
+
+        template<size_t Step, typename... Args, size_t... Is>
+        static void add_chain_links(std::vector<uint64_t>& links,
+            [[maybe_unused]] std::index_sequence<Is...> iseq,
+            [[maybe_unused]] const std::tuple<Args...>& args)
+        {
+            (
+                [&links]
+                {
+                    using arg_t = std::remove_cv_t<std::remove_reference_t<Args>>;
+
+                    if constexpr (is_chain_ref_v<arg_t>)
+                    {
+                        static_assert(
+                            arg_t::step < Step, "A chained call may only use earlier results");
+
+                        links.push_back(Is);
+                        links.push_back(arg_t::step);
+                    }
+                }(),
+                ...);
+        }
+
+        // Earlier results are sent as a default value of their type, replaced by the server
+        template<typename Results, bool IsMap, typename T>
+        static decltype(auto) resolve_chain_arg(T& arg)
+        {
+            using arg_t = std::remove_cv_t<T>;
+
+            if constexpr (is_chain_ref_v<arg_t>)
+            {
+                using source_t = std::tuple_element_t<arg_t::step, Results>;
+
+                if constexpr (IsMap)
+                {
+                    return typename source_t::value_type{};
+                }
+                else
+                {
+                    return source_t{};
+                }
+            }
+            else
+            {
+                return static_cast<const arg_t&>(arg);
+            }
+        }
+
+        template<typename Results, typename R, bool IsMap, typename... Args>
+        static typename chained_call<R, IsMap, Args...>::result_t complete_chain(
+            const typename Serial::serial_t& response,
+            [[maybe_unused]] chained_call<R, IsMap, Args...>& call)
+        {
+            using result_t = typename chained_call<R, IsMap, Args...>::result_t;
+
+            return deserialize_call<result_t,
+                decltype(resolve_chain_arg<Results, IsMap>(std::declval<Args&>()))...>(response)
+                .get_result();
+        }
+
+        template<typename... Calls, size_t... Is>
+        static auto complete_batch(std::vector<std::optional<typename Serial::serial_t>>& responses,
+            [[maybe_unused]] std::index_sequence<Is...> iseq, Calls&... calls)
+        {
+            return std::make_tuple(complete_batch_call(calls, std::move(responses[Is]))...);
+        }
+
+        template<typename R, typename... Args>
+        auto await_response(const uint64_t call_id)
+        {
+            return deserialize_call<R, Args...>(receive_response(call_id));
+        }
+
+        // Only one caller reads from the transport at a time, the others wait for their response to
+        // be routed to them, or for the transport to be free so they can read it themselves
+        typename Serial::serial_t receive_response(const uint64_t call_id)
+        {
+            while (true)
+            {
+                {
+                    std::unique_lock<std::mutex> lock{ m_mtx };
+                    m_recv_cv.wait(lock,
+                        [this, call_id]
+                        {
+                            return !m_receiving || m_responses.count(call_id) != 0
+                                || call_id <= m_failed_through;
+                        });
+
+                    if (const auto it = m_responses.find(call_id); it != m_responses.end())
+                    {
+                        auto serial_obj = std::move(it->second);
+                        m_responses.erase(it);
+                        return serial_obj;
+                    }
+
+                    if (call_id <= m_failed_through)
+                    {
+                        std::rethrow_exception(m_stream_error);
+                    }
+
+                    m_receiving = true;
+                    m_reader = std::this_thread::get_id();
+                }
+
+                auto ret_obj = [this]
+                {
+                    try
+                    {
+                        return read_response();
+                    }
+                    catch (...)
+                    {
+                        fail_outstanding(std::current_exception());
+                        release_receive();
+                        throw;
+                    }
+                }();
+
+                const auto recv_id = Serial::get_call_id(ret_obj);
+
+                if (recv_id == 0)
+                {
+                    const auto error = unattributed_error(ret_obj);
+                    fail_outstanding(error);
+                    release_receive();
+                    std::rethrow_exception(error);
+                }
+
+                if (recv_id == call_id)
+                {
+                    release_receive();
+                    return ret_obj;
+                }
+
+                route_response(recv_id, std::move(ret_obj));
+                release_receive();
+            }
+        }
+
+        typename Serial::serial_t read_response()
+        {
+            auto ret_obj = [this]
+            {
+                try
+                {
+                    return Serial::from_bytes(receive());
+                }
+                catch (const std::exception& ex)
+                {
+                    throw client_receive_error(ex.what());
+                }
+            }();
+
+            if (!ret_obj.has_value())
+            {
+                throw client_receive_error("Client received invalid RPC object");
+            }
+
+            return std::move(ret_obj).value();
+        }
+
+        // Wakes the waiters once the transport is free, and carries on receiving for any
+        // asynchronous calls that are still outstanding
+        void release_receive()
+        {
+            bool handed_off = false;
+
+            {
+                std::lock_guard<std::mutex> lock{ m_mtx };
+                m_receiving = false;
+                handed_off = m_receive_waiters != 0;
+            }
+
+            m_recv_cv.notify_all();
+
+            if (auto* const loop = current_receive_loop(); loop != nullptr && loop->client == this)
+            {
+                // Completed inline, so the loop that started the receive starts the next one
+                loop->completed = true;
+                return;
+            }
+
+            if (!handed_off)
+            {
+                continue_async_receive();
+            }
+        }
+
+        // Receive loop running on the calling thread, which receives that complete inline go
+        // back to instead of recursing
+        struct receive_loop
+        {
+            explicit receive_loop(const client_interface* loop_client) noexcept
+                : client(loop_client), outer(std::exchange(current_receive_loop(), this))
+            {
+            }
+
+            ~receive_loop() noexcept { current_receive_loop() = outer; }
+
+            receive_loop(const receive_loop&) = delete;
+            receive_loop(receive_loop&&) = delete;
+            receive_loop& operator=(const receive_loop&) = delete;
+            receive_loop& operator=(receive_loop&&) = delete;
+
+            const client_interface* client;
+            receive_loop* outer;
+            bool completed{ false };
+        };
+
+        static receive_loop*& current_receive_loop() noexcept
+        {
+            thread_local receive_loop* loop = nullptr;
+            return loop;
+        }
+
+        // Starts receiving for the outstanding asynchronous calls, unless a receive is in progress.
+        // With a transport that receives inline, this keeps receiving until no calls are left,
+        // waiting its turn while another thread reads
+        void continue_async_receive()
+        {
+            if (auto* const loop = current_receive_loop(); loop != nullptr && loop->client == this)
+            {
+                return;
+            }
+
+            receive_loop loop{ this };
+
+            do
+            {
+                loop.completed = false;
+
+                {
+                    std::unique_lock<std::mutex> lock{ m_mtx };
+
+                    // Never waits on this thread's own read, which only ends once this returns
+                    if (m_inline_receive && m_receiving
+                        && m_reader != std::this_thread::get_id())
+                    {
+                        ++m_receive_waiters;
+                        m_recv_cv.wait(
+                            lock, [this] { return !m_receiving || m_handlers.empty(); });
+                        --m_receive_waiters;
+                    }
+
+                    if (m_receiving || m_handlers.empty())
+                    {
+                        break;
+                    }
+
+                    m_receiving = true;
+                    m_reader = std::this_thread::get_id();
+                }
+
+                try
+                {
+                    async_receive([this](typename Serial::bytes_t&& recv_bytes,
+                                      const std::exception_ptr& recv_error)
+                        { complete_receive(std::move(recv_bytes), recv_error); });
+                }
+                catch (...)
+                {
+                    complete_receive(typename Serial::bytes_t{}, std::current_exception());
+                }
+            } while (loop.completed);
+        }
+
+        void route_response(const uint64_t recv_id, typename Serial::serial_t&& serial_obj)
+        {
+            std::unique_lock<std::mutex> lock{ m_mtx };
+
+            if (const auto it = m_handlers.find(recv_id); it != m_handlers.end())
+            {
+                auto handler = std::move(it->second);
+                m_handlers.erase(it);
+                lock.unlock();
+                handler(std::move(serial_obj), nullptr);
+                return;
+            }
+
+            // Calls that have already failed, or were dropped, never claim their response
+            if (recv_id > m_failed_through && m_discarded.erase(recv_id) == 0)
+            {
+                m_responses.insert_or_assign(recv_id, std::move(serial_obj));
+                lock.unlock();
+                m_recv_cv.notify_all();
+            }
+        }
+
+        // A response without an ID is the server's error for a request it could not read, which
+        // cannot be matched to any one call
+        static std::exception_ptr unattributed_error(const typename Serial::serial_t& serial_obj)
+        {
+            try
+            {
+                deserialize_call<void>(serial_obj).get_result();
+            }
+            catch (...)
+            {
+                return std::current_exception();
+            }
+
+            return std::make_exception_ptr(
+                client_receive_error("Client received invalid RPC object"));
+        }
+
+        // The stream can no longer be trusted, so every outstanding call fails with @p error, and
+        // any response that still arrives for one of them is dropped
+        void fail_outstanding(const std::exception_ptr& error)
+        {
+            std::unique_lock<std::mutex> lock{ m_mtx };
+            m_failed_through = m_next_call_id - 1;
+            m_stream_error = error;
+            m_discarded.clear();
+            auto handlers = std::move(m_handlers);
+            m_handlers.clear();
+            lock.unlock();
+
+            m_recv_cv.notify_all();
+
+            for (auto& [id, handler] : handlers)
+            {
+                handler(Serial::empty_object(), error);
+            }
+        }
+
+        void discard_response(const uint64_t call_id) noexcept
+        {
+            try
+            {
+                std::lock_guard<std::mutex> lock{ m_mtx };
+
+                if (m_responses.erase(call_id) == 0 && call_id > m_failed_through)
+                {
+                    m_discarded.insert(call_id);
+                }
+            }
+            catch (...)
+            {
+                // If the ID cannot be tracked, its response is held until the client is destroyed
+            }
+        }
+
+        void add_handler(const uint64_t call_id, response_handler_t&& handler)
+        {
+            std::lock_guard<std::mutex> lock{ m_mtx };
+            m_handlers.insert_or_assign(call_id, std::move(handler));
+        }
+
+        void fail_call(const uint64_t call_id, const std::exception_ptr& error)
+        {
+            std::unique_lock<std::mutex> lock{ m_mtx };
+
+            if (const auto it = m_handlers.find(call_id); it != m_handlers.end())
+            {
+                auto handler = std::move(it->second);
+                m_handlers.erase(it);
+                lock.unlock();
+                handler(Serial::empty_object(), error);
+            }
+        }
+
+        void complete_receive(typename Serial::bytes_t&& bytes, const std::exception_ptr& error)
+        {
+            auto ret_obj = [&bytes, &error]() -> std::optional<typename Serial::serial_t>
+            {
+                if (error)
+                {
+                    return std::nullopt;
+                }
+
+                try
+                {
+                    return Serial::from_bytes(std::move(bytes));
+                }
+                catch (...)
+                {
+                    return std::nullopt;
+                }
+            }();
+
+            if (!ret_obj.has_value())
+            {
+                fail_outstanding(error ? wrap_error<client_receive_error>(error)
+                                       : std::make_exception_ptr(client_receive_error(
+                                           "Client received invalid RPC object")));
+
+                release_receive();
+                return;
+            }
+
+            if (const auto recv_id = Serial::get_call_id(ret_obj.value()); recv_id == 0)
+            {
+                fail_outstanding(unattributed_error(ret_obj.value()));
+            }
+            else
+            {
+                route_response(recv_id, std::move(ret_obj).value());
+            }
+
+            release_receive();
+        }
+
+        template<typename Ex>
+        static std::exception_ptr wrap_error(const std::exception_ptr& error) noexcept
+        {
+            try
+            {
+                std::rethrow_exception(error);
+            }
+            catch (const std::exception& ex)
+            {
+                return std::make_exception_ptr(Ex(ex.what()));
+            }
+            catch (...)
+            {
+                return std::make_exception_ptr(Ex("Unknown error"));
+            }
+        }
+
+        std::atomic<uint64_t> m_next_call_id{ 1 };
+        mutable std::mutex m_mtx{};
+        std::unordered_map<uint64_t, typename Serial::serial_t> m_responses{};
+        std::unordered_set<uint64_t> m_discarded{};
+
+        // Calls up to this ID were outstanding when the stream failed, and fail with its error
+        uint64_t m_failed_through{ 0 };
+        std::exception_ptr m_stream_error{};
+
+        // Set while a caller (or an asynchronous receive) is reading from the transport
+        bool m_receiving{ false };
+        std::thread::id m_reader{};
+        std::condition_variable m_recv_cv{};
+
+        // Set once async_receive is seen to receive inline, and the number of threads waiting to
+        // receive for the asynchronous calls in that case
+        std::atomic<bool> m_inline_receive{ false };
+        size_t m_receive_waiters{ 0 };
+
+        // Ordered so the oldest outstanding call is first
+        std::map<uint64_t, response_handler_t> m_handlers{};
     };
 } // namespace client
 #endif
@@ -40,14 +40,29 @@
 
 #include <bitsery/bitsery.h>
 #include <bitsery/adapter/buffer.h>
-#include <bitsery/ext/std_tuple.h>
+#include <bitsery/adapter/measure_size.h>
+#include <bitsery/ext/compact_value.h>
 #include <bitsery/traits/array.h>
 #include <bitsery/traits/string.h>
 #include <bitsery/traits/vector.h>
 
+#include <array>
 #include <cassert>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <string_view>
 #include <vector>
 
+#if defined(__cpp_lib_span) || (__cplusplus >= 202002L && __has_include(<span>))
+#    include <span>
+#    define RPC_HPP_BITSERY_HAS_SPAN
+#endif
+
+#if defined(RPC_HPP_BITSERY_EXACT_SZ) && defined(RPC_HPP_BITSERY_COMPACT_SZ)
+#    error "RPC_HPP_BITSERY_EXACT_SZ and RPC_HPP_BITSERY_COMPACT_SZ cannot both be defined"
+#endif
+
 #if defined(RPC_HPP_ENABLE_SERVER_CACHE)
 #    include <numeric>
 
@@ -71,30 +86,54 @@ namespace rpc_hpp
 {
 namespace adapters
 {
-    class bitsery_adapter;
+    enum class bitsery_encoding
+    {
+        // Arithmetic arguments are widened to 64 bits, so caller and server types need not match
+        wide,
+        // Arithmetic arguments are written at their own size
+        exact,
+        // Integers are written as variable-length values (zig-zag encoded when signed)
+        compact,
+    };
+
+    // The limits are part of the adapter's type, so the size of a message can be bounded by its
+    // signature at compile time
+    template<bitsery_encoding Encoding, uint64_t MaxFuncNameSize = 30,
+        uint64_t MaxStringSize = 2048, uint64_t MaxContainerSize = 1000>
+    struct bitsery_config
+    {
+        static constexpr bitsery_encoding encoding = Encoding;
+        static constexpr bool use_exact_size = Encoding == bitsery_encoding::exact;
+        static constexpr bool use_compact_size = Encoding == bitsery_encoding::compact;
 
-    template<>
-    struct serial_traits<bitsery_adapter>
+        static constexpr uint64_t max_func_name_size = MaxFuncNameSize;
+        static constexpr uint64_t max_string_size = MaxStringSize;
+        static constexpr uint64_t max_container_size = MaxContainerSize;
+    };
+
+    // Mixed into the signature of calls using a type with its own serialize function, so types
+    // of the same size and alignment can be told apart by specializing it
+    template<typename T>
+    struct bitsery_type_tag : std::integral_constant<uint64_t, 0>
+    {
+    };
+
+    template<typename Config>
+    class basic_bitsery_adapter;
+
+    template<typename Config>
+    struct serial_traits<basic_bitsery_adapter<Config>>
     {
         using serial_t = std::vector<uint8_t>;
         using bytes_t = std::vector<uint8_t>;
     };
 
-    class bitsery_adapter : public detail::serial_adapter_base<bitsery_adapter>
+    template<typename Config>
+    class basic_bitsery_adapter :
+        public detail::serial_adapter_base<basic_bitsery_adapter<Config>>
     {
     public:
-        struct config
-        {
-#if defined(RPC_HPP_BITSERY_EXACT_SZ)
-            static constexpr bool use_exact_size = true;
-#else
-            static constexpr bool use_exact_size = false;
-#endif
-
-            static const uint64_t max_func_name_size;
-            static const uint64_t max_string_size;
-            static const uint64_t max_container_size;
-        };
+        using config = Config;
 
         [[nodiscard]] static std::vector<uint8_t> to_bytes(std::vector<uint8_t>&& serial_obj)
         {
@@ -104,130 +143,453 @@ namespace adapters
         [[nodiscard]] static std::optional<std::vector<uint8_t>> from_bytes(
             std::vector<uint8_t>&& bytes)
         {
-            // TODO: Verify bitsery data somehow
+            if (!validate_header(bytes))
+            {
+                return std::nullopt;
+            }
+
             return std::make_optional(std::move(bytes));
         }
 
-        static std::vector<uint8_t> empty_object()
+        static std::vector<uint8_t> empty_object() { return write_helper(response_helper<void>{}); }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static std::vector<uint8_t> serialize_request(
+            const detail::request_view<Args...>& request)
+        {
+            return write_helper<max_request_size<Args...>()>(
+                request_writer<Args...>{ request, hash_signature<R, Args...>() });
+        }
+
+        // Everything before the arguments, with a call ID of zero
+        template<typename R, typename... Args>
+        [[nodiscard]] static std::vector<uint8_t> prepare_request(const std::string& func_name)
+        {
+            return write_helper<max_request_size<>()>(request_writer<>{
+                detail::request_view<>{ 0, func_name, {} }, hash_signature<R, Args...>() });
+        }
+
+        template<typename... Args>
+        [[nodiscard]] static std::vector<uint8_t> serialize_prepared(
+            const std::vector<uint8_t>& prepared, const detail::request_view<Args...>& request)
+        {
+            static constexpr size_t max_size = max_request_size<Args...>();
+
+            if constexpr (max_size <= max_presized_message_size)
+            {
+                RPC_HPP_PRECONDITION(prepared.size() <= max_request_size<>());
+
+                // Left uninitialized, only the bytes written are read
+                std::array<uint8_t, max_size> buffer;
+                std::memcpy(buffer.data(), prepared.data(), prepared.size());
+
+                const auto bytes_written = write_prepared<array_output_adapter<max_size>>(
+                    buffer, prepared.size(), request);
+
+                return std::vector<uint8_t>(buffer.data(), buffer.data() + bytes_written);
+            }
+            else
+            {
+                bitsery::Serializer<bitsery::MeasureSize> measure{};
+                serialize_args(measure, request.get_args(),
+                    detail::packed_func_base<Args...>::all_args,
+                    std::index_sequence_for<Args...>{});
+
+                // Sized to the whole message, as growing it in bitsery's adapter reallocates and
+                // zero-fills
+                std::vector<uint8_t> buffer(
+                    prepared.size() + measure.adapter().writtenBytesCount());
+
+                std::memcpy(buffer.data(), prepared.data(), prepared.size());
+
+                const auto bytes_written =
+                    write_prepared<output_adapter>(buffer, prepared.size(), request);
+
+                buffer.resize(bytes_written);
+                return buffer;
+            }
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_request(
+            const std::vector<uint8_t>& serial_obj)
         {
-            std::vector<uint8_t> buffer(sizeof(int) + 2);
-            bitsery::quickSerialization<output_adapter>(buffer, pack_helper<void>{});
-            return buffer;
+            // Checked before any argument is read, so a mismatched call fails without decoding
+            if (get_signature(serial_obj) != hash_signature<R, Args...>())
+            {
+                throw function_mismatch("RPC error: Called function signature does not match");
+            }
+
+            request_helper<Args...> helper{};
+            helper.view_buffer = &serial_obj;
+            read_helper(serial_obj, helper);
+
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack{ std::move(helper.func_name),
+                    std::move(helper.args) };
+
+                pack.set_call_id(helper.call_id);
+                return pack;
+            }
+            else
+            {
+                detail::packed_func<R, Args...> pack{ std::move(helper.func_name), std::nullopt,
+                    std::move(helper.args) };
+
+                pack.set_call_id(helper.call_id);
+                return pack;
+            }
         }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static std::vector<uint8_t> serialize_pack(
+        [[nodiscard]] static std::vector<uint8_t> serialize_response(
             const detail::packed_func<R, Args...>& pack)
         {
-            const auto helper = to_helper(pack);
-            std::vector<uint8_t> buffer{};
-            buffer.reserve(64);
+            if (!pack)
+            {
+                response_helper<void> helper{};
+                helper.except_type = static_cast<int>(pack.get_except_type());
+                helper.call_id = pack.get_call_id();
+                helper.err_mesg = pack.get_err_mesg().substr(0, config::max_string_size);
+                return write_helper(helper);
+            }
 
-            const auto bytes_written = bitsery::quickSerialization<output_adapter>(buffer, helper);
-            buffer.resize(bytes_written);
-            return buffer;
+            return write_helper<max_response_size<R, Args...>()>(
+                response_writer<R, Args...>{ pack });
         }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_response(
             const std::vector<uint8_t>& serial_obj)
         {
-            pack_helper<R, Args...> helper{};
+            response_helper<R, Args...> helper{};
+            read_helper(serial_obj, helper);
+
+            auto pack = [&helper]
+            {
+                if constexpr (std::is_void_v<R>)
+                {
+                    return detail::packed_func<void, Args...>{ std::string{},
+                        std::move(helper.args) };
+                }
+                else
+                {
+                    return detail::packed_func<R, Args...>{ std::string{},
+                        helper.except_type == 0 ? std::make_optional(std::move(helper.result))
+                                                : std::nullopt,
+                        std::move(helper.args) };
+                }
+            }();
+
+            pack.set_call_id(helper.call_id);
+            pack.set_arg_mask(helper.arg_mask);
+
+            if (helper.except_type != 0)
+            {
+                pack.set_exception(
+                    std::move(helper.err_mesg), static_cast<exception_type>(helper.except_type));
+            }
+
+            return pack;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<void, Args...> deserialize_response_into(
+            const std::vector<uint8_t>& serial_obj, R& result)
+        {
+            response_reader<R, Args...> reader{ 0, 0, {}, 0, result, {} };
+            read_helper(serial_obj, reader);
+
+            detail::packed_func<void, Args...> pack{ std::string{}, std::move(reader.args) };
+            pack.set_call_id(reader.call_id);
+            pack.set_arg_mask(reader.arg_mask);
+
+            if (reader.except_type != 0)
+            {
+                pack.set_exception(
+                    std::move(reader.err_mesg), static_cast<exception_type>(reader.except_type));
+            }
+
+            return pack;
+        }
+
+        [[nodiscard]] static std::vector<uint8_t> make_batch(
+            const uint64_t call_id, std::vector<std::vector<uint8_t>>&& serial_objs)
+        {
+            batch_helper helper{};
+            helper.call_id = call_id;
+            helper.calls = std::move(serial_objs);
+            return write_helper(helper);
+        }
+
+        [[nodiscard]] static bool is_batch(const std::vector<uint8_t>& serial_obj)
+        {
+            if (serial_obj.size() < header_size)
+            {
+                return false;
+            }
+
+            int ex_type = 0;
+            memcpy(&ex_type, serial_obj.data(), sizeof(int));
+            return ex_type == batch_marker;
+        }
+
+        [[nodiscard]] static std::vector<std::optional<std::vector<uint8_t>>> split_batch(
+            std::vector<uint8_t>&& serial_obj)
+        {
+            batch_helper helper{};
 
             if (const auto [error, _] = bitsery::quickDeserialization(
                     input_adapter{ serial_obj.begin(), serial_obj.size() }, helper);
                 error != bitsery::ReaderError::NoError)
             {
-                switch (error)
-                {
-                    case bitsery::ReaderError::ReadingError:
-                        throw deserialization_error(
-                            "Bitsery deserialization failed due to a reading error");
+                return {};
+            }
 
-                    case bitsery::ReaderError::DataOverflow:
-                        throw function_mismatch("Bitsery deserialization failed due to data "
-                                                "overflow (likely mismatched "
-                                                "function signature)");
+            return validate_calls(std::move(helper.calls));
+        }
 
-                    case bitsery::ReaderError::InvalidData:
-                        throw deserialization_error(
-                            "Bitsery deserialization failed due to a invalid data");
+        [[nodiscard]] static std::vector<uint8_t> make_map(const uint64_t call_id,
+            const std::string& func_name, std::vector<std::vector<uint8_t>>&& serial_objs)
+        {
+            map_helper helper{};
+            helper.call_id = call_id;
+            helper.func_name = func_name;
+            helper.calls = std::move(serial_objs);
+            return write_helper(helper);
+        }
 
-                    case bitsery::ReaderError::InvalidPointer:
-                        throw deserialization_error(
-                            "Bitsery deserialization failed due to an invalid pointer");
+        [[nodiscard]] static bool is_map(const std::vector<uint8_t>& serial_obj)
+        {
+            if (serial_obj.size() < header_size)
+            {
+                return false;
+            }
 
-                    case bitsery::ReaderError::NoError:
-                    default:
-                        throw deserialization_error(
-                            "Bitsery deserialization failed due to extra data on the end");
-                }
+            int ex_type = 0;
+            memcpy(&ex_type, serial_obj.data(), sizeof(int));
+            return ex_type == map_marker;
+        }
+
+        [[nodiscard]] static std::vector<std::optional<std::vector<uint8_t>>> split_map(
+            std::vector<uint8_t>&& serial_obj)
+        {
+            map_helper helper{};
+
+            if (const auto [error, _] = bitsery::quickDeserialization(
+                    input_adapter{ serial_obj.begin(), serial_obj.size() }, helper);
+                error != bitsery::ReaderError::NoError)
+            {
+                return {};
+            }
+
+            return validate_calls(std::move(helper.calls));
+        }
+
+        [[nodiscard]] static std::vector<uint8_t> make_chain(
+            const uint64_t call_id, std::vector<std::vector<uint8_t>>&& serial_objs)
+        {
+            batch_helper helper{};
+            helper.marker = chain_marker;
+            helper.call_id = call_id;
+            helper.calls = std::move(serial_objs);
+            return write_helper(helper);
+        }
+
+        [[nodiscard]] static bool is_chain(const std::vector<uint8_t>& serial_obj)
+        {
+            if (serial_obj.size() < header_size)
+            {
+                return false;
+            }
+
+            int ex_type = 0;
+            memcpy(&ex_type, serial_obj.data(), sizeof(int));
+            return ex_type == chain_marker;
+        }
+
+        [[nodiscard]] static std::vector<std::optional<std::vector<uint8_t>>> split_chain(
+            std::vector<uint8_t>&& serial_obj)
+        {
+            // A chain is laid out like a batch, only the marker differs
+            return split_batch(std::move(serial_obj));
+        }
+
+        [[nodiscard]] static uint64_t get_call_id(const std::vector<uint8_t>& serial_obj)
+        {
+            if (serial_obj.size() < header_size)
+            {
+                return 0;
             }
 
-            return from_helper(helper);
+            return read_uint64(serial_obj, sizeof(int));
         }
 
         [[nodiscard]] static std::string get_func_name(const std::vector<uint8_t>& serial_obj)
         {
-            size_t index = sizeof(int);
-            const auto len = extract_length(serial_obj, index);
+            size_t index = header_size;
+            size_t len = 0;
 
-            assert(index < serial_obj.size());
-            assert(index <= std::numeric_limits<ptrdiff_t>::max());
+            if (!read_length(serial_obj, index, len))
+            {
+                return {};
+            }
 
-            return { std::next(serial_obj.begin(), index),
-                std::next(serial_obj.begin(), index + len) };
+            const auto name_begin = std::next(serial_obj.begin(), static_cast<ptrdiff_t>(index));
+            return { name_begin, std::next(name_begin, static_cast<ptrdiff_t>(len)) };
         }
 
         [[nodiscard]] static rpc_exception extract_exception(const std::vector<uint8_t>& serial_obj)
         {
-            const auto pack = deserialize_pack<void>(serial_obj);
-            return rpc_exception{ pack.get_err_mesg(), pack.get_except_type() };
+            // Only the header and error message are needed, the rest of the response is ignored
+            response_helper<void> helper{};
+            std::ignore = bitsery::quickDeserialization(
+                input_adapter{ serial_obj.begin(), serial_obj.size() }, helper);
+
+            return rpc_exception{ std::move(helper.err_mesg),
+                static_cast<exception_type>(helper.except_type) };
         }
 
         static void set_exception(std::vector<uint8_t>& serial_obj, const rpc_exception& ex)
         {
-            // copy except_type into buffer
-            const int ex_type = static_cast<int>(ex.get_type());
-            memcpy(&serial_obj[0], &ex_type, sizeof(int));
+            // Error responses only carry the error, not the rest of the call
             const std::string_view mesg = ex.what();
-            const auto new_err_len = static_cast<unsigned>(mesg.size());
+            response_helper<void> helper{};
+            helper.except_type = static_cast<int>(ex.get_type());
+            helper.call_id = get_call_id(serial_obj);
+            helper.err_mesg = mesg.substr(0, config::max_string_size);
+
+            // Written over the request in one pass, so its storage is reused
+            serial_obj.clear();
+            const auto bytes_written =
+                bitsery::quickSerialization<output_adapter>(serial_obj, helper);
+
+            serial_obj.resize(bytes_written);
+        }
 
-            size_t index = sizeof(int);
-            const auto name_len = extract_length(serial_obj, index);
-            const size_t name_sz_len = index;
+    private:
+        // except_type + call_id
+        static constexpr size_t header_size = sizeof(int) + sizeof(uint64_t);
 
-            index += name_len;
+        using bit_buffer = std::vector<uint8_t>;
 
-            if (const auto err_len = extract_length(serial_obj, index); new_err_len != err_len)
+        // Bitsery's buffer adapters, which can also hand out a block of the buffer, so that
+        // fixed-size arguments are copied in place after one bounds check for all of them
+        template<typename Buffer>
+        class basic_output_adapter : public bitsery::OutputBufferAdapter<Buffer>
+        {
+        public:
+            // Implicit like bitsery's, which quickSerialization relies on
+            basic_output_adapter(Buffer& buffer) :
+                bitsery::OutputBufferAdapter<Buffer>(buffer), m_buffer(&buffer)
             {
-                if (err_len != 0)
-                {
-                    assert(index < serial_obj.size());
-                    assert(index <= std::numeric_limits<ptrdiff_t>::max());
+            }
 
-                    serial_obj.erase(std::next(serial_obj.begin(), name_sz_len + name_len),
-                        std::next(serial_obj.begin(), index + err_len));
-                }
+            // Grows the buffer as needed, the block must be filled before anything else is written
+            [[nodiscard]] uint8_t* write_block(const size_t size)
+            {
+                const size_t pos = this->currentWritePos();
+                this->currentWritePos(pos + size);
+                return m_buffer->data() + pos;
+            }
+
+        private:
+            Buffer* m_buffer;
+        };
+
+        using output_adapter = basic_output_adapter<bit_buffer>;
 
-                index = name_sz_len + name_len;
-                write_length(serial_obj, new_err_len, index);
+        // Used for messages with a bounded size, which can never outgrow it
+        template<size_t N>
+        using array_output_adapter = basic_output_adapter<std::array<uint8_t, N>>;
+
+        class input_adapter : public bitsery::InputBufferAdapter<bit_buffer>
+        {
+        public:
+            input_adapter(const bit_buffer::const_iterator begin, const size_t size) :
+                bitsery::InputBufferAdapter<bit_buffer>(begin, size),
+                m_data(size != 0 ? &*begin : nullptr),
+                m_size(size)
+            {
             }
 
-            for (unsigned i = 0; i < new_err_len; ++i)
+            // Null (with the adapter's error set) if the buffer is too short to hold the block
+            [[nodiscard]] const uint8_t* read_block(const size_t size)
             {
-                assert(index < serial_obj.size());
-                assert(index <= std::numeric_limits<ptrdiff_t>::max());
+                const size_t pos = this->currentReadPos();
+
+                if (this->error() != bitsery::ReaderError::NoError || size > m_size - pos)
+                {
+                    this->error(bitsery::ReaderError::DataOverflow);
+                    return nullptr;
+                }
 
-                serial_obj.insert(
-                    std::next(serial_obj.begin(), index++), static_cast<unsigned char>(mesg[i]));
+                this->currentReadPos(pos + size);
+                return m_data + pos;
             }
-        }
 
-    private:
-        using bit_buffer = std::vector<uint8_t>;
-        using output_adapter = bitsery::OutputBufferAdapter<bit_buffer>;
-        using input_adapter = bitsery::InputBufferAdapter<bit_buffer>;
+        private:
+            const uint8_t* m_data;
+            size_t m_size;
+        };
+
+        // Stored in place of except_type to mark a single call, so a request can be told apart from
+        // a response
+        static constexpr int call_marker = -4;
+
+        // Stored in place of except_type to mark a batch of calls
+        static constexpr int batch_marker = -1;
+
+        // Limit on the size of a single call in a batch (largest length bitsery can encode)
+        static constexpr size_t max_batch_call_size = 0x3FFFFFFFU;
+
+        struct batch_helper
+        {
+            int marker{ batch_marker };
+            uint64_t call_id{};
+            std::vector<bit_buffer> calls{};
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                s.template value<sizeof(int)>(marker);
+                s.value8b(call_id);
+                check_length<S>(calls.size(), config::max_container_size);
+                s.container(calls, config::max_container_size,
+                    [](S& s2, bit_buffer& call)
+                    { s2.container1b(call, max_batch_call_size); });
+            }
+        };
+
+        // Stored in place of except_type to mark a chain of calls (laid out as a batch)
+        static constexpr int chain_marker = -3;
+
+        // Stored in place of except_type to mark a map of calls to one function, the calls in a
+        // map are packed with an empty func_name
+        static constexpr int map_marker = -2;
+
+        // Laid out like a call header so that get_call_id and get_func_name work on a map
+        struct map_helper
+        {
+            int marker{ map_marker };
+            uint64_t call_id{};
+            std::string func_name{};
+            std::vector<bit_buffer> calls{};
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                s.template value<sizeof(int)>(marker);
+                s.value8b(call_id);
+                check_length<S>(func_name.size(), config::max_func_name_size);
+                s.text1b(func_name, config::max_func_name_size);
+                check_length<S>(calls.size(), config::max_container_size);
+                s.container(calls, config::max_container_size,
+                    [](S& s2, bit_buffer& call)
+                    { s2.container1b(call, max_batch_call_size); });
+            }
+        };
 
         // NOTE: This jank can be replaced once C++20 is adopted
         template<typename T,
@@ -263,279 +625,1251 @@ namespace adapters
         template<typename T>
         using largest_t = typename largest<T>::type;
 
-        template<typename R, typename... Args>
-        struct pack_helper
+        // Arguments a handler can take as views into the request, only spans of single bytes are
+        // supported, as wider elements would be misaligned
+        template<typename T>
+        struct is_byte_span : std::false_type
         {
-            static_assert(!std::is_same_v<R, long double>,
-                "long double is not supported for RPC bitsery serialization!");
+        };
 
-#if defined(RPC_HPP_BITSERY_EXACT_SZ)
-            using args_t = std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>;
-#else
-            using args_t =
-                std::tuple<largest_t<std::remove_cv_t<std::remove_reference_t<Args>>>...>;
+#if defined(RPC_HPP_BITSERY_HAS_SPAN)
+        template<typename T>
+        struct is_byte_span<std::span<const T>> :
+            std::bool_constant<sizeof(T) == 1
+                && (std::is_arithmetic_v<T> || std::is_same_v<T, std::byte>)>
+        {
+        };
 #endif
 
-            pack_helper() = default;
-
-            int except_type{};
-            std::string func_name{};
-            std::string err_mesg{};
-            R result{};
-            args_t args{};
-
-            template<typename S>
-            void serialize(S& s)
-            {
-                s.template value<sizeof(int)>(except_type);
-                s.text1b(func_name, config::max_func_name_size);
-                s.text1b(err_mesg, config::max_string_size);
+        template<typename T>
+        static constexpr bool is_view_v =
+            std::is_same_v<T, std::string_view> || is_byte_span<T>::value;
 
-                if constexpr (std::is_arithmetic_v<R>)
-                {
-                    s.template value<sizeof(R)>(result);
-                }
-                else if constexpr (rpc_hpp::detail::is_container_v<R>)
-                {
-                    if constexpr (std::is_arithmetic_v<typename R::value_type>)
-                    {
-                        s.template container<sizeof(typename R::value_type)>(
-                            result, config::max_container_size);
-                    }
-                    else
-                    {
-                        s.container(result, config::max_container_size);
-                    }
-                }
-                else
-                {
-                    s.object(result);
-                }
+        template<typename S>
+        static constexpr bool is_reader_v =
+            std::is_same_v<std::remove_reference_t<decltype(std::declval<S&>().adapter())>,
+                input_adapter>;
 
-                s.ext(args,
-                    ::bitsery::ext::StdTuple{ [](S& s2, std::string& str)
-                        { s2.text1b(str, config::max_string_size); },
-                        // Fallback serializer for integers, floats, and enums
-                        [](auto& s2, auto& val)
-                        {
-                            using T = std::remove_cv_t<std::remove_reference_t<decltype(val)>>;
-
-                            if constexpr (std::is_arithmetic_v<T>)
-                            {
-                                if constexpr (config::use_exact_size)
-                                {
-                                    s2.template value<sizeof(val)>(val);
-                                }
-                                else
-                                {
-                                    s2.value8b(val);
-                                }
-                            }
-                            else if constexpr (rpc_hpp::detail::is_container_v<T>)
-                            {
-                                if constexpr (std::is_arithmetic_v<typename T::value_type>)
-                                {
-                                    s2.template container<sizeof(typename T::value_type)>(
-                                        val, config::max_container_size);
-                                }
-                                else
-                                {
-                                    s2.container(val, config::max_container_size);
-                                }
-                            }
-                            else
-                            {
-                                s2.object(val);
-                            }
-                        } });
-            }
+        template<typename Adapter>
+        struct is_output_adapter : std::false_type
+        {
         };
 
-        template<typename... Args>
-        struct pack_helper<void, Args...>
+        template<typename Buffer>
+        struct is_output_adapter<basic_output_adapter<Buffer>> : std::true_type
         {
-#if defined(RPC_HPP_BITSERY_EXACT_SZ)
-            using args_t = std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>;
-#else
-            using args_t =
-                std::tuple<largest_t<std::remove_cv_t<std::remove_reference_t<Args>>>...>;
-#endif
+        };
 
-            pack_helper() = default;
+        // Measuring serializers are neither
+        template<typename S>
+        static constexpr bool is_writer_v = is_output_adapter<
+            std::remove_reference_t<decltype(std::declval<S&>().adapter())>>::value;
 
-            int except_type{};
-            std::string func_name{};
-            std::string err_mesg{};
-            args_t args{};
+        // Integers written with bitsery's CompactValue extension, bool is left as a single byte
+        // unless it is widened
+        template<typename T>
+        static constexpr bool is_compact_v = config::use_compact_size && std::is_integral_v<T>;
 
-            template<typename S>
-            void serialize(S& s)
-            {
-                s.template value<sizeof(int)>(except_type);
+        template<typename T>
+        static constexpr bool is_compact_exact_v = is_compact_v<T> && !std::is_same_v<T, bool>;
+
+        // Whether bitsery writes values in the host's byte order (taken from bitsery itself, so it
+        // always agrees with the per-value path), in which case their bytes can be copied as-is
+        static constexpr bool is_native_order =
+            bitsery::details::getSystemEndianness() == bitsery::DefaultConfig::Endianness;
+
+        // Arrays of numbers are written without a length, and copied as one block when the host's
+        // byte order matches bitsery's
+        template<typename T>
+        struct is_bulk_array : std::false_type
+        {
+        };
+
+        template<typename T, size_t N>
+        struct is_bulk_array<std::array<T, N>> :
+            std::bool_constant<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>
+        {
+        };
+
+        // Values whose bytes in memory are exactly what bitsery would write for them
+        template<typename T>
+        static constexpr bool is_fixed_v = is_native_order
+            && ((std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !is_compact_v<T>)
+                || is_bulk_array<T>::value);
+
+        template<typename T, typename = void>
+        struct has_serialize_func : std::false_type
+        {
+        };
+
+        template<typename T>
+        struct has_serialize_func<T,
+            std::void_t<decltype(serialize(
+                std::declval<bitsery::Serializer<output_adapter>&>(), std::declval<T&>()))>> :
+            std::true_type
+        {
+        };
+
+        template<typename T, typename = void>
+        struct has_serialize_method : std::false_type
+        {
+        };
+
+        template<typename T>
+        struct has_serialize_method<T,
+            std::void_t<decltype(std::declval<T&>().serialize(
+                std::declval<bitsery::Serializer<output_adapter>&>()))>> : std::true_type
+        {
+        };
+
+        // Aggregates without a serialize function of their own are written field by field
+        template<typename T>
+        static constexpr bool is_reflected_v = std::is_aggregate_v<T> && !std::is_array_v<T>
+            && !rpc_hpp::detail::is_container_v<T> && !has_serialize_func<T>::value
+            && !has_serialize_method<T>::value;
+
+        static constexpr size_t max_reflected_fields = 16;
+
+        // Converts to any type, so an aggregate's fields can be counted by initializing it
+        struct any_field
+        {
+            template<typename T>
+            operator T() const;
+        };
+
+        template<typename T, typename Fields, typename = void>
+        struct is_brace_constructible : std::false_type
+        {
+        };
+
+        template<typename T, typename... Fields>
+        struct is_brace_constructible<T, std::tuple<Fields...>,
+            std::void_t<decltype(T{ std::declval<Fields>()... })>> : std::true_type
+        {
+        };
+
+        // NOTE: Fields that are C arrays are counted once per element, see has_array_fields
+        template<typename T, typename... Fields>
+        [[nodiscard]] static constexpr size_t count_fields() noexcept
+        {
+            if constexpr (sizeof...(Fields) <= max_reflected_fields
+                && is_brace_constructible<T, std::tuple<Fields..., any_field>>::value)
+            {
+                return count_fields<T, Fields..., any_field>();
+            }
+            else
+            {
+                return sizeof...(Fields);
+            }
+        }
+
+        template<typename T, typename Fields, typename = void>
+        struct is_each_brace_constructible : std::false_type
+        {
+        };
+
+        template<typename T, typename... Fields>
+        struct is_each_brace_constructible<T, std::tuple<Fields...>,
+            std::void_t<decltype(T{ { std::declval<Fields>() }... })>> : std::true_type
+        {
+        };
+
+        // With its own braces, each initializer is one field, so a C array (counted once per
+        // element) leaves more initializers than fields
+        template<typename T, size_t... Is>
+        [[nodiscard]] static constexpr bool has_array_fields(
+            [[maybe_unused]] std::index_sequence<Is...> iseq) noexcept
+        {
+            return !is_each_brace_constructible<T,
+                std::tuple<decltype((void)Is, std::declval<any_field>())...>>::value;
+        }
+
+        template<typename T>
+        using wire_arg_t = std::conditional_t<config::use_exact_size,
+            std::remove_cv_t<std::remove_reference_t<T>>,
+            largest_t<std::remove_cv_t<std::remove_reference_t<T>>>>;
+
+        template<typename... Args>
+        using args_helper_t = std::tuple<wire_arg_t<Args>...>;
+
+        template<typename Tuple, size_t I>
+        using wire_elem_t = wire_arg_t<std::tuple_element_t<I, std::remove_cv_t<Tuple>>>;
+
+        template<typename Tuple, size_t... Is>
+        static constexpr bool is_fixed_block_v = sizeof...(Is) != 0
+            && (is_fixed_v<wire_elem_t<Tuple, Is>> && ...);
+
+        // Messages that can be no larger than this are written without being measured first
+        static constexpr size_t max_presized_message_size = 1024;
+
+        static constexpr size_t unbounded_size = std::numeric_limits<size_t>::max();
+
+        // Containers written with a length, which is limited by max_container_size
+        template<typename T>
+        struct is_sized_container : std::false_type
+        {
+        };
+
+        template<typename T, typename Alloc>
+        struct is_sized_container<std::vector<T, Alloc>> : std::true_type
+        {
+        };
+
+        template<typename C, typename Traits, typename Alloc>
+        struct is_sized_container<std::basic_string<C, Traits, Alloc>> : std::true_type
+        {
+        };
+
+        [[nodiscard]] static constexpr size_t add_size(const size_t lhs, const size_t rhs) noexcept
+        {
+            return lhs > unbounded_size - rhs ? unbounded_size : lhs + rhs;
+        }
+
+        [[nodiscard]] static constexpr size_t mul_size(
+            const uint64_t count, const size_t size) noexcept
+        {
+            return size != 0 && count > unbounded_size / size ? unbounded_size : count * size;
+        }
+
+        // Bytes bitsery uses for a length of up to max_len
+        [[nodiscard]] static constexpr size_t length_size(const uint64_t max_len) noexcept
+        {
+            return max_len < 0x80U ? 1 : (max_len < 0x4000U ? 2 : 4);
+        }
+
+        // Bytes the CompactValue extension uses for an integer of the given size
+        [[nodiscard]] static constexpr size_t compact_size(const size_t size) noexcept
+        {
+            return (size * 8 + 6) / 7;
+        }
+
+        [[nodiscard]] static constexpr size_t max_sized_size(
+            const uint64_t max_count, const size_t elem_size) noexcept
+        {
+            return add_size(length_size(max_count), mul_size(max_count, elem_size));
+        }
+
+        // Largest encoding of a value written by serialize_result, as long as it is within the
+        // configured limits (aggregates and objects are not bounded)
+        template<typename T>
+        [[nodiscard]] static constexpr size_t max_result_size() noexcept
+        {
+            if constexpr (std::is_void_v<T>)
+            {
+                return 0;
+            }
+            else if constexpr (is_compact_exact_v<T>)
+            {
+                return compact_size(sizeof(T));
+            }
+            else if constexpr (std::is_arithmetic_v<T> || is_bulk_array<T>::value)
+            {
+                return sizeof(T);
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                return max_result_size<std::underlying_type_t<T>>();
+            }
+            else if constexpr (is_sized_container<T>::value)
+            {
+                return max_sized_size(
+                    config::max_container_size, max_result_size<typename T::value_type>());
+            }
+            else
+            {
+                return unbounded_size;
+            }
+        }
+
+        // Largest encoding of an argument written by serialize_arg, T is its wire type
+        template<typename T>
+        [[nodiscard]] static constexpr size_t max_arg_size() noexcept
+        {
+            if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>)
+            {
+                return max_sized_size(config::max_string_size, 1);
+            }
+            else if constexpr (is_byte_span<T>::value)
+            {
+                return max_sized_size(config::max_container_size, 1);
+            }
+            else if constexpr (is_compact_v<T>)
+            {
+                return compact_size(sizeof(uint64_t));
+            }
+            else if constexpr (std::is_arithmetic_v<T>)
+            {
+                return sizeof(T);
+            }
+            else if constexpr (std::is_enum_v<T>)
+            {
+                return max_arg_size<wire_arg_t<std::underlying_type_t<T>>>();
+            }
+            else
+            {
+                return max_result_size<T>();
+            }
+        }
+
+        // Saturates, so that one unbounded argument leaves the whole request unbounded
+        template<typename... Args>
+        [[nodiscard]] static constexpr size_t max_args_size() noexcept
+        {
+            size_t size = 0;
+            ((size = add_size(size, max_arg_size<wire_arg_t<Args>>())), ...);
+            return size;
+        }
+
+        // Marker, call ID, function name, and signature, followed by every argument
+        template<typename... Args>
+        [[nodiscard]] static constexpr size_t max_request_size() noexcept
+        {
+            return add_size(sizeof(int) + sizeof(uint64_t) * 2
+                    + max_sized_size(config::max_func_name_size, 1),
+                max_args_size<Args...>());
+        }
+
+        // Marker, call ID, and argument mask, followed by the result and (at most) every argument
+        template<typename R, typename... Args>
+        [[nodiscard]] static constexpr size_t max_response_size() noexcept
+        {
+            return add_size(add_size(header_size + compact_size(sizeof(uint64_t)),
+                                max_result_size<R>()),
+                max_args_size<Args...>());
+        }
+
+        // Requests only carry the function identity and every argument
+        template<typename... Args>
+        struct request_helper
+        {
+            // The batch, map, and chain markers share its position
+            int marker{ call_marker };
+            uint64_t call_id{};
+            std::string func_name{};
+            uint64_t signature{};
+            args_helper_t<Args...> args{};
+
+            // Buffer being read, that view arguments refer into (not serialized)
+            const bit_buffer* view_buffer{};
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                s.template value<sizeof(int)>(marker);
+                s.value8b(call_id);
+                check_length<S>(func_name.size(), config::max_func_name_size);
                 s.text1b(func_name, config::max_func_name_size);
-                s.text1b(err_mesg, config::max_string_size);
-
-                s.ext(args,
-                    bitsery::ext::StdTuple{ [](S& s2, std::string& str)
-                        { s2.text1b(str, config::max_string_size); },
-                        // Fallback serializer for integers, floats, and enums
-                        [](auto& s2, auto& val)
-                        {
-                            using T = std::remove_cv_t<std::remove_reference_t<decltype(val)>>;
-
-                            if constexpr (std::is_arithmetic_v<T>)
-                            {
-                                if constexpr (config::use_exact_size)
-                                {
-                                    s2.template value<sizeof(val)>(val);
-                                }
-                                else
-                                {
-                                    s2.value8b(val);
-                                }
-                            }
-                            else if constexpr (rpc_hpp::detail::is_container_v<T>)
-                            {
-                                if constexpr (std::is_arithmetic_v<typename T::value_type>)
-                                {
-                                    s2.template container<sizeof(typename T::value_type)>(
-                                        val, config::max_container_size);
-                                }
-                                else
-                                {
-                                    s2.container(val, config::max_container_size);
-                                }
-                            }
-                            else
-                            {
-                                s2.object(val);
-                            }
-                        } });
-            }
-        };
-
-        // nodiscard because a potentially expensive copy and allocation is being done
+                s.value8b(signature);
+                serialize_args(s, args, detail::packed_func_base<Args...>::all_args,
+                    std::index_sequence_for<Args...>{}, view_buffer);
+            }
+        };
+
+        // Writes a request in the layout of request_helper, straight from the caller's arguments
+        template<typename... Args>
+        struct request_writer
+        {
+            const detail::request_view<Args...>& request;
+            uint64_t signature;
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                s.template value<sizeof(int)>(call_marker);
+                s.value8b(request.get_call_id());
+                check_length<S>(request.get_func_name().size(), config::max_func_name_size);
+                s.text1b(request.get_func_name(), config::max_func_name_size);
+                s.value8b(signature);
+                serialize_args(s, request.get_args(), detail::packed_func_base<Args...>::all_args,
+                    std::index_sequence_for<Args...>{});
+            }
+        };
+
+        // Responses carry either the error message, or the result and the arguments sent back
         template<typename R, typename... Args>
-        [[nodiscard]] static pack_helper<R, Args...> to_helper(
-            const detail::packed_func<R, Args...>& pack)
+        struct response_helper
+        {
+            static_assert(!std::is_same_v<R, long double>,
+                "long double is not supported for RPC bitsery serialization!");
+
+            int except_type{};
+            uint64_t call_id{};
+            std::string err_mesg{};
+            uint64_t arg_mask{};
+            R result{};
+            args_helper_t<Args...> args{};
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                s.template value<sizeof(int)>(except_type);
+                s.value8b(call_id);
+
+                if (except_type != 0)
+                {
+                    s.text1b(err_mesg, config::max_string_size);
+                    return;
+                }
+
+                s.ext8b(arg_mask, bitsery::ext::CompactValue{});
+                serialize_result(s, result);
+                serialize_args(s, args, arg_mask, std::index_sequence_for<Args...>{});
+            }
+        };
+
+        // Reads a response in the layout of response_helper, the result is read into the
+        // caller's object so its storage can be reused
+        template<typename R, typename... Args>
+        struct response_reader
+        {
+            int except_type{};
+            uint64_t call_id{};
+            std::string err_mesg{};
+            uint64_t arg_mask{};
+            R& result;
+            args_helper_t<Args...> args{};
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                s.template value<sizeof(int)>(except_type);
+                s.value8b(call_id);
+
+                if (except_type != 0)
+                {
+                    s.text1b(err_mesg, config::max_string_size);
+                    return;
+                }
+
+                s.ext8b(arg_mask, bitsery::ext::CompactValue{});
+                serialize_result(s, result);
+                serialize_args(s, args, arg_mask, std::index_sequence_for<Args...>{});
+            }
+        };
+
+        // Writes a successful response in the layout of response_helper, straight from the pack
+        template<typename R, typename... Args>
+        struct response_writer
+        {
+            const detail::packed_func<R, Args...>& pack;
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                const uint64_t arg_mask = pack.get_arg_mask();
+
+                s.template value<sizeof(int)>(0);
+                s.value8b(pack.get_call_id());
+                s.ext8b(arg_mask, bitsery::ext::CompactValue{});
+
+                if constexpr (!std::is_void_v<R>)
+                {
+                    serialize_result(s, pack.get_result());
+                }
+
+                serialize_args(s, pack.get_args(), arg_mask, std::index_sequence_for<Args...>{});
+            }
+        };
+
+        template<typename... Args>
+        struct response_helper<void, Args...>
+        {
+            int except_type{};
+            uint64_t call_id{};
+            std::string err_mesg{};
+            uint64_t arg_mask{};
+            args_helper_t<Args...> args{};
+
+            template<typename S>
+            void serialize(S& s)
+            {
+                s.template value<sizeof(int)>(except_type);
+                s.value8b(call_id);
+
+                if (except_type != 0)
+                {
+                    s.text1b(err_mesg, config::max_string_size);
+                    return;
+                }
+
+                s.ext8b(arg_mask, bitsery::ext::CompactValue{});
+                serialize_args(s, args, arg_mask, std::index_sequence_for<Args...>{});
+            }
+        };
+
+// Names for the fields of an aggregate, bound by apply_fields
+#define RPC_HPP_BITSERY_FIELDS_1 f1
+#define RPC_HPP_BITSERY_FIELDS_2 RPC_HPP_BITSERY_FIELDS_1, f2
+#define RPC_HPP_BITSERY_FIELDS_3 RPC_HPP_BITSERY_FIELDS_2, f3
+#define RPC_HPP_BITSERY_FIELDS_4 RPC_HPP_BITSERY_FIELDS_3, f4
+#define RPC_HPP_BITSERY_FIELDS_5 RPC_HPP_BITSERY_FIELDS_4, f5
+#define RPC_HPP_BITSERY_FIELDS_6 RPC_HPP_BITSERY_FIELDS_5, f6
+#define RPC_HPP_BITSERY_FIELDS_7 RPC_HPP_BITSERY_FIELDS_6, f7
+#define RPC_HPP_BITSERY_FIELDS_8 RPC_HPP_BITSERY_FIELDS_7, f8
+#define RPC_HPP_BITSERY_FIELDS_9 RPC_HPP_BITSERY_FIELDS_8, f9
+#define RPC_HPP_BITSERY_FIELDS_10 RPC_HPP_BITSERY_FIELDS_9, f10
+#define RPC_HPP_BITSERY_FIELDS_11 RPC_HPP_BITSERY_FIELDS_10, f11
+#define RPC_HPP_BITSERY_FIELDS_12 RPC_HPP_BITSERY_FIELDS_11, f12
+#define RPC_HPP_BITSERY_FIELDS_13 RPC_HPP_BITSERY_FIELDS_12, f13
+#define RPC_HPP_BITSERY_FIELDS_14 RPC_HPP_BITSERY_FIELDS_13, f14
+#define RPC_HPP_BITSERY_FIELDS_15 RPC_HPP_BITSERY_FIELDS_14, f15
+#define RPC_HPP_BITSERY_FIELDS_16 RPC_HPP_BITSERY_FIELDS_15, f16
+
+#define RPC_HPP_BITSERY_APPLY_FIELDS(N)                                                        \
+    else if constexpr (count == (N))                                                           \
+    {                                                                                          \
+        auto& [RPC_HPP_BITSERY_FIELDS_##N] = val;                                              \
+        return std::forward<F>(func)(RPC_HPP_BITSERY_FIELDS_##N);                              \
+    }
+
+        // Calls func with a reference to each field of the aggregate, in declaration order
+        template<typename T, typename F>
+        static decltype(auto) apply_fields([[maybe_unused]] T& val, F&& func)
+        {
+            static constexpr size_t count = count_fields<std::remove_cv_t<T>>();
+
+            static constexpr bool too_many = count > max_reflected_fields;
+            static constexpr bool has_arrays =
+                has_array_fields<std::remove_cv_t<T>>(std::make_index_sequence<count>{});
+
+            static_assert(!too_many,
+                "Aggregates with more than 16 fields need a serialize function for RPC bitsery "
+                "serialization!");
+
+            static_assert(!has_arrays,
+                "Aggregates with C array fields need a serialize function for RPC bitsery "
+                "serialization!");
+
+            // Unsupported aggregates are not destructured, so only the assertions above fail
+            if constexpr (count == 0 || too_many || has_arrays)
+            {
+                return std::forward<F>(func)();
+            }
+            RPC_HPP_BITSERY_APPLY_FIELDS(1)
+            RPC_HPP_BITSERY_APPLY_FIELDS(2)
+            RPC_HPP_BITSERY_APPLY_FIELDS(3)
+            RPC_HPP_BITSERY_APPLY_FIELDS(4)
+            RPC_HPP_BITSERY_APPLY_FIELDS(5)
+            RPC_HPP_BITSERY_APPLY_FIELDS(6)
+            RPC_HPP_BITSERY_APPLY_FIELDS(7)
+            RPC_HPP_BITSERY_APPLY_FIELDS(8)
+            RPC_HPP_BITSERY_APPLY_FIELDS(9)
+            RPC_HPP_BITSERY_APPLY_FIELDS(10)
+            RPC_HPP_BITSERY_APPLY_FIELDS(11)
+            RPC_HPP_BITSERY_APPLY_FIELDS(12)
+            RPC_HPP_BITSERY_APPLY_FIELDS(13)
+            RPC_HPP_BITSERY_APPLY_FIELDS(14)
+            RPC_HPP_BITSERY_APPLY_FIELDS(15)
+            RPC_HPP_BITSERY_APPLY_FIELDS(16)
+        }
+
+#undef RPC_HPP_BITSERY_APPLY_FIELDS
+#undef RPC_HPP_BITSERY_FIELDS_1
+#undef RPC_HPP_BITSERY_FIELDS_2
+#undef RPC_HPP_BITSERY_FIELDS_3
+#undef RPC_HPP_BITSERY_FIELDS_4
+#undef RPC_HPP_BITSERY_FIELDS_5
+#undef RPC_HPP_BITSERY_FIELDS_6
+#undef RPC_HPP_BITSERY_FIELDS_7
+#undef RPC_HPP_BITSERY_FIELDS_8
+#undef RPC_HPP_BITSERY_FIELDS_9
+#undef RPC_HPP_BITSERY_FIELDS_10
+#undef RPC_HPP_BITSERY_FIELDS_11
+#undef RPC_HPP_BITSERY_FIELDS_12
+#undef RPC_HPP_BITSERY_FIELDS_13
+#undef RPC_HPP_BITSERY_FIELDS_14
+#undef RPC_HPP_BITSERY_FIELDS_15
+#undef RPC_HPP_BITSERY_FIELDS_16
+
+        template<typename S, typename T>
+        static void serialize_fields(S& s, T& val)
+        {
+            apply_fields(val, [&s](auto&... fields) { serialize_each(s, fields...); });
+        }
+
+        // Only used in unevaluated contexts, to name the types of an aggregate's fields
+        struct field_types_fn
+        {
+            template<typename... Fields>
+            std::tuple<std::remove_cv_t<Fields>...>* operator()(Fields&... /*unused*/) const;
+        };
+
+        template<typename T>
+        using field_tuple_t = std::remove_pointer_t<decltype(
+            apply_fields(std::declval<T&>(), std::declval<field_types_fn>()))>;
+
+        // Fields are written at their own size, like results
+        template<typename S, typename... Fields>
+        static void serialize_each(S& s, Fields&... fields)
+        {
+            (serialize_result(s, fields), ...);
+        }
+
+        template<typename S, typename T>
+        static void serialize_array(S& s, T& arr)
+        {
+            if constexpr (is_native_order)
+            {
+                serialize_bytes(s, arr.data(), sizeof(arr));
+            }
+            else
+            {
+                s.template container<sizeof(typename std::remove_cv_t<T>::value_type)>(arr);
+            }
+        }
+
+        // Copies the bytes as they are in memory
+        template<typename S, typename T>
+        static void serialize_bytes(S& s, T* data, const size_t size)
+        {
+            if constexpr (is_reader_v<S>)
+            {
+                s.adapter().template readBuffer<1>(reinterpret_cast<uint8_t*>(data), size);
+            }
+            else
+            {
+                s.adapter().template writeBuffer<1>(reinterpret_cast<const uint8_t*>(data), size);
+            }
+        }
+
+        template<typename S, typename R>
+        static void serialize_result(S& s, R& result)
+        {
+            using no_cv_t = std::remove_cv_t<R>;
+
+            static_assert(!std::is_same_v<no_cv_t, long double>,
+                "long double is not supported for RPC bitsery serialization!");
+
+            if constexpr (is_compact_exact_v<no_cv_t>)
+            {
+                s.template ext<sizeof(R)>(result, bitsery::ext::CompactValue{});
+            }
+            else if constexpr (std::is_arithmetic_v<no_cv_t>)
+            {
+                s.template value<sizeof(R)>(result);
+            }
+            else if constexpr (std::is_enum_v<no_cv_t>)
+            {
+                // Written as the underlying integer
+                auto underlying = static_cast<std::underlying_type_t<no_cv_t>>(result);
+                serialize_result(s, underlying);
+
+                if constexpr (is_reader_v<S>)
+                {
+                    result = static_cast<no_cv_t>(underlying);
+                }
+            }
+            else if constexpr (is_bulk_array<no_cv_t>::value)
+            {
+                serialize_array(s, result);
+            }
+            else if constexpr (rpc_hpp::detail::is_container_v<no_cv_t>)
+            {
+                serialize_container(s, result);
+            }
+            else if constexpr (is_reflected_v<no_cv_t>)
+            {
+                serialize_fields(s, result);
+            }
+            else
+            {
+                // Anything else must have its own serialize function
+                s.object(result);
+            }
+        }
+
+        template<typename S, typename C>
+        static void serialize_container(S& s, C& val)
         {
-            pack_helper<R, Args...> helper{};
-            helper.func_name = pack.get_func_name();
-            helper.args = pack.get_args();
+            using value_t = typename std::remove_cv_t<C>::value_type;
 
-            if (!pack)
+            check_length<S>(val.size(), config::max_container_size);
+
+            if constexpr (is_compact_exact_v<value_t>)
             {
-                helper.except_type = static_cast<int>(pack.get_except_type());
-                helper.err_mesg = pack.get_err_mesg();
-                return helper;
+                s.container(val, config::max_container_size,
+                    [](S& s2, auto& elem)
+                    { s2.template ext<sizeof(value_t)>(elem, bitsery::ext::CompactValue{}); });
+            }
+            else if constexpr (std::is_arithmetic_v<value_t>)
+            {
+                s.template container<sizeof(value_t)>(val, config::max_container_size);
+            }
+            else
+            {
+                // Strings, nested containers, and aggregates are not objects to bitsery
+                s.container(val, config::max_container_size,
+                    [](S& s2, auto& elem) { serialize_result(s2, elem); });
             }
+        }
 
-            if constexpr (!std::is_void_v<R>)
+        // Messages no larger than MaxSize are written to a buffer on the stack, which the limits
+        // keep them from outgrowing, and copied out at their actual size. Larger or unbounded
+        // messages are measured first, so the buffer is allocated once
+        template<size_t MaxSize = unbounded_size, typename Helper>
+        [[nodiscard]] static std::vector<uint8_t> write_helper(const Helper& helper)
+        {
+            if constexpr (MaxSize <= max_presized_message_size)
             {
-                helper.result = pack.get_result();
+                // Left uninitialized, only the bytes written are read
+                std::array<uint8_t, MaxSize> buffer;
+                const auto bytes_written =
+                    bitsery::quickSerialization<array_output_adapter<MaxSize>>(buffer, helper);
+
+                return std::vector<uint8_t>(buffer.data(), buffer.data() + bytes_written);
             }
+            else
+            {
+                std::vector<uint8_t> buffer(
+                    bitsery::quickSerialization(bitsery::MeasureSize{}, helper));
+
+                const auto bytes_written =
+                    bitsery::quickSerialization<output_adapter>(buffer, helper);
 
-            return helper;
+                buffer.resize(bytes_written);
+                return buffer;
+            }
         }
 
-        // nodiscard because a potentially expensive copy and allocation is being done
-        template<typename R, typename... Args>
-        [[nodiscard]] static detail::packed_func<R, Args...> from_helper(
-            pack_helper<R, Args...> helper)
+        // Fills in the call ID and arguments of a buffer starting with a prepared request
+        template<typename Adapter, typename Buffer, typename... Args>
+        static size_t write_prepared(Buffer& buffer, const size_t prepared_size,
+            const detail::request_view<Args...>& request)
         {
-            if constexpr (std::is_void_v<R>)
+            bitsery::Serializer<Adapter> ser{ buffer };
+
+            // The call ID follows the marker
+            ser.adapter().currentWritePos(sizeof(int));
+            ser.value8b(request.get_call_id());
+            ser.adapter().currentWritePos(prepared_size);
+
+            serialize_args(ser, request.get_args(), detail::packed_func_base<Args...>::all_args,
+                std::index_sequence_for<Args...>{});
+
+            ser.adapter().flush();
+            return ser.adapter().writtenBytesCount();
+        }
+
+        // Bitsery only asserts its limits, so lengths are checked before they are written, which
+        // also keeps bounded messages within the size computed from their signature
+        template<typename S>
+        static void check_length([[maybe_unused]] const size_t length,
+            [[maybe_unused]] const uint64_t max_length)
+        {
+            if constexpr (!is_reader_v<S>)
             {
-                if (helper.except_type == 0)
+                if (length > max_length)
                 {
-                    return detail::packed_func<void, Args...>{ std::move(helper.func_name),
-                        std::move(helper.args) };
+                    throw serialization_error("Bitsery serialization failed due to a string or "
+                                              "container exceeding the configured size limit");
                 }
+            }
+        }
 
-                detail::packed_func<void, Args...> pack{ std::move(helper.func_name),
-                    std::move(helper.args) };
+        template<typename Helper>
+        static void read_helper(const std::vector<uint8_t>& serial_obj, Helper& helper)
+        {
+            if (const auto [error, completed] = bitsery::quickDeserialization(
+                    input_adapter{ serial_obj.begin(), serial_obj.size() }, helper);
+                error != bitsery::ReaderError::NoError || !completed)
+            {
+                switch (error)
+                {
+                    case bitsery::ReaderError::ReadingError:
+                        throw deserialization_error(
+                            "Bitsery deserialization failed due to a reading error");
 
-                pack.set_exception(
-                    std::move(helper.err_mesg), static_cast<exception_type>(helper.except_type));
+                    case bitsery::ReaderError::DataOverflow:
+                        throw function_mismatch("Bitsery deserialization failed due to data "
+                                                "overflow (likely mismatched "
+                                                "function signature)");
 
-                return pack;
+                    case bitsery::ReaderError::InvalidData:
+                        throw deserialization_error(
+                            "Bitsery deserialization failed due to a invalid data");
+
+                    case bitsery::ReaderError::InvalidPointer:
+                        throw deserialization_error(
+                            "Bitsery deserialization failed due to an invalid pointer");
+
+                    case bitsery::ReaderError::NoError:
+                        // Most likely a call made with more arguments than the function takes
+                        throw function_mismatch("Bitsery deserialization failed due to extra "
+                                                "data on the end (likely mismatched function "
+                                                "signature)");
+
+                    default:
+                        throw deserialization_error(
+                            "Bitsery deserialization failed due to an unknown error");
+                }
             }
-            else
+        }
+
+        // Only the arguments marked in the mask are on the wire
+        template<typename S, typename Tuple, size_t... Is>
+        static void serialize_args(S& s, Tuple& args, [[maybe_unused]] const uint64_t arg_mask,
+            std::index_sequence<Is...> /*unused*/,
+            [[maybe_unused]] const bit_buffer* view_buffer = nullptr)
+        {
+            if constexpr (is_fixed_block_v<Tuple, Is...> && (is_reader_v<S> || is_writer_v<S>))
             {
-                if (helper.err_mesg.empty())
+                if (arg_mask == (uint64_t{ 1 } << sizeof...(Is)) - 1)
                 {
-                    return detail::packed_func<R, Args...>{ std::move(helper.func_name),
-                        std::move(helper.result), std::move(helper.args) };
+                    serialize_fixed_args(s, args, std::index_sequence<Is...>{});
+                    return;
                 }
+            }
 
-                detail::packed_func<R, Args...> pack{ std::move(helper.func_name), std::nullopt,
-                    std::move(helper.args) };
+            ((((arg_mask >> Is) & 1U) != 0 ? serialize_arg(s, std::get<Is>(args), view_buffer)
+                                           : void()),
+                ...);
+        }
 
-                pack.set_exception(
-                    std::move(helper.err_mesg), static_cast<exception_type>(helper.except_type));
+        // Laid out exactly as serialize_arg would write each argument, but copied straight to or
+        // from the buffer, so it is bounds-checked once for all of them
+        template<typename S, typename Tuple, size_t... Is>
+        static void serialize_fixed_args(
+            S& s, Tuple& args, std::index_sequence<Is...> /*unused*/)
+        {
+            static constexpr size_t block_size = (sizeof(wire_elem_t<Tuple, Is>) + ...);
+            size_t offset = 0;
 
-                return pack;
+            if constexpr (is_reader_v<S>)
+            {
+                const uint8_t* const block = s.adapter().read_block(block_size);
+
+                if (block == nullptr)
+                {
+                    return;
+                }
+
+                ((std::memcpy(&std::get<Is>(args), block + offset, sizeof(wire_elem_t<Tuple, Is>)),
+                     offset += sizeof(wire_elem_t<Tuple, Is>)),
+                    ...);
+            }
+            else
+            {
+                uint8_t* const block = s.adapter().write_block(block_size);
+
+                ((write_fixed<wire_elem_t<Tuple, Is>>(block + offset, std::get<Is>(args)),
+                     offset += sizeof(wire_elem_t<Tuple, Is>)),
+                    ...);
             }
         }
 
-        // Borrowed from Bitsery library for compatibility
-        static unsigned extract_length(const bit_buffer& bytes, size_t& index) noexcept
+        // Widened first when writing a request from the caller's (narrower) arguments
+        template<typename Wire, typename T>
+        static void write_fixed(uint8_t* dest, const T& val) noexcept
         {
-            RPC_HPP_PRECONDITION(index < bytes.size());
+            if constexpr (std::is_same_v<std::remove_cv_t<T>, Wire>)
+            {
+                std::memcpy(dest, &val, sizeof(Wire));
+            }
+            else
+            {
+                const Wire wire_val = static_cast<Wire>(val);
+                std::memcpy(dest, &wire_val, sizeof(Wire));
+            }
+        }
 
-            const uint8_t hb = bytes[index++];
+        template<typename S, typename T>
+        static void serialize_arg(
+            S& s, T& val, [[maybe_unused]] const bit_buffer* view_buffer = nullptr)
+        {
+            using no_cv_t = std::remove_cv_t<T>;
 
-            if (hb < 0x80U)
+            if constexpr (std::is_same_v<no_cv_t, std::string>)
             {
-                return hb;
+                check_length<S>(val.size(), config::max_string_size);
+                s.text1b(val, config::max_string_size);
+            }
+            else if constexpr (is_view_v<no_cv_t>)
+            {
+                if constexpr (is_reader_v<S>)
+                {
+                    read_view(s, val, view_buffer);
+                }
+                else
+                {
+                    write_view(s, val);
+                }
+            }
+            else if constexpr (is_compact_v<no_cv_t>)
+            {
+                // Widened like the other integers, so the encoding does not depend on their size
+                if constexpr (sizeof(val) == sizeof(largest_t<no_cv_t>))
+                {
+                    s.ext8b(val, bitsery::ext::CompactValue{});
+                }
+                else
+                {
+                    // Only reached when writing a request from the caller's (narrower) arguments
+                    s.ext8b(
+                        static_cast<largest_t<no_cv_t>>(val), bitsery::ext::CompactValue{});
+                }
+            }
+            else if constexpr (std::is_arithmetic_v<no_cv_t>)
+            {
+                if constexpr (config::use_exact_size)
+                {
+                    s.template value<sizeof(val)>(val);
+                }
+                else if constexpr (sizeof(val) == sizeof(largest_t<no_cv_t>))
+                {
+                    s.value8b(val);
+                }
+                else
+                {
+                    // Only reached when writing a request from the caller's (narrower) arguments
+                    s.value8b(static_cast<largest_t<no_cv_t>>(val));
+                }
             }
+            else if constexpr (std::is_enum_v<no_cv_t>)
+            {
+                // Written as the underlying integer would be, widened by the same encodings
+                using underlying_t = wire_arg_t<std::underlying_type_t<no_cv_t>>;
 
-            assert(index < bytes.size());
-            const uint8_t lb = bytes[index++];
+                auto underlying = static_cast<underlying_t>(val);
+                serialize_arg(s, underlying);
 
-            if ((hb & 0x40U) != 0U)
+                if constexpr (is_reader_v<S>)
+                {
+                    val = static_cast<no_cv_t>(underlying);
+                }
+            }
+            else if constexpr (is_bulk_array<no_cv_t>::value)
             {
-                assert(index < bytes.size());
-                const uint16_t lw = *reinterpret_cast<const uint16_t*>(&bytes[index++]);
-                return ((((hb & 0x3FU) << 8) | lb) << 16) | lw;
+                serialize_array(s, val);
+            }
+            else if constexpr (rpc_hpp::detail::is_container_v<no_cv_t>)
+            {
+                serialize_container(s, val);
+            }
+            else if constexpr (is_reflected_v<no_cv_t>)
+            {
+                serialize_fields(s, val);
+            }
+            else
+            {
+                // Anything else must have its own serialize function
+                s.object(val);
             }
-
-            return ((hb & 0x7FU) << 8) | lb;
         }
 
-        // Borrowed from Bitsery library for compatibility
-        static void write_length(bit_buffer& bytes, size_t size, size_t& index)
+        // Views are laid out like the string or container they refer to: a bitsery length, then
+        // the bytes
+        template<typename S, typename T>
+        static void write_view(S& s, const T& val)
         {
-            RPC_HPP_PRECONDITION(size < 0x40000000U);
+            const uint64_t max_size = std::is_same_v<T, std::string_view>
+                ? config::max_string_size
+                : config::max_container_size;
+
+            const auto size = val.size();
+
+            // Checked before anything is written, the reader would reject the message anyway
+            if (size > max_size || size >= 0x40000000U)
+            {
+                throw serialization_error("Bitsery serialization failed due to a view exceeding "
+                                          "the configured size limit");
+            }
+
+            auto& writer = s.adapter();
 
+            // Same encoding as bitsery's container lengths
             if (size < 0x80U)
             {
-                assert(index < size);
-                assert(index <= std::numeric_limits<ptrdiff_t>::max());
+                writer.template writeBytes<1>(static_cast<uint8_t>(size));
+            }
+            else if (size < 0x4000U)
+            {
+                writer.template writeBytes<1>(static_cast<uint8_t>((size >> 8U) | 0x80U));
+                writer.template writeBytes<1>(static_cast<uint8_t>(size));
+            }
+            else
+            {
+                writer.template writeBytes<1>(static_cast<uint8_t>((size >> 24U) | 0xC0U));
+                writer.template writeBytes<1>(static_cast<uint8_t>(size >> 16U));
+                writer.template writeBytes<2>(static_cast<uint16_t>(size));
+            }
+
+            writer.template writeBuffer<1>(reinterpret_cast<const uint8_t*>(val.data()), size);
+        }
 
-                bytes.insert(std::next(bytes.begin(), index++), static_cast<uint8_t>(size));
+        // Points the view into the request buffer instead of copying, it remains valid until
+        // the request is replaced by its response
+        template<typename S, typename T>
+        static void read_view(S& s, T& val, const bit_buffer* view_buffer)
+        {
+            using value_t = std::remove_cv_t<typename T::value_type>;
+            const uint64_t max_size = std::is_same_v<T, std::string_view>
+                ? config::max_string_size
+                : config::max_container_size;
+
+            auto& reader = s.adapter();
+
+            if (view_buffer == nullptr)
+            {
+                // Only requests can be read into views, responses do not outlive the call
+                reader.error(bitsery::ReaderError::InvalidData);
                 return;
             }
 
-            if (size < 0x4000U)
+            size_t index = reader.currentReadPos();
+            size_t size = 0;
+
+            if (!read_length(*view_buffer, index, size))
             {
-                bytes.insert(
-                    std::next(bytes.begin(), index++), static_cast<uint8_t>((size >> 8) | 0x80U));
+                reader.error(bitsery::ReaderError::DataOverflow);
+                return;
+            }
 
-                bytes.insert(std::next(bytes.begin(), index++), static_cast<uint8_t>(size));
+            if (size > max_size)
+            {
+                reader.error(bitsery::ReaderError::InvalidData);
                 return;
             }
 
-            bytes.insert(
-                std::next(bytes.begin(), index++), static_cast<uint8_t>((size >> 24) | 0xC0U));
+            val = T{ reinterpret_cast<const value_t*>(view_buffer->data() + index), size };
+            reader.currentReadPos(index + size);
+        }
+
+        // FNV-1a, over a tag for each type in a signature
+        static constexpr uint64_t fnv_offset_basis = 0xCBF29CE484222325ULL;
+        static constexpr uint64_t fnv_prime = 0x100000001B3ULL;
+
+        [[nodiscard]] static constexpr uint64_t hash_value(
+            uint64_t hash, const uint64_t val) noexcept
+        {
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                hash ^= (val >> (8U * i)) & 0xFFU;
+                hash *= fnv_prime;
+            }
+
+            return hash;
+        }
+
+        // Types are identified by how they are written rather than by name, so the fingerprint
+        // does not depend on the compiler, and types written alike (like std::string and
+        // std::string_view) may be used in place of each other
+        template<typename T>
+        [[nodiscard]] static constexpr uint64_t hash_type(const uint64_t hash) noexcept
+        {
+            using no_cv_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+            if constexpr (std::is_void_v<no_cv_t>)
+            {
+                return hash_value(hash, 1);
+            }
+            else if constexpr (std::is_same_v<no_cv_t, std::string>
+                || std::is_same_v<no_cv_t, std::string_view>)
+            {
+                return hash_value(hash, 2);
+            }
+            else if constexpr (std::is_arithmetic_v<no_cv_t>)
+            {
+                return hash_value(hash,
+                    (uint64_t{ 3 } << 16U) | (uint64_t{ std::is_floating_point_v<no_cv_t> } << 9U)
+                        | (uint64_t{ std::is_signed_v<no_cv_t> } << 8U) | sizeof(no_cv_t));
+            }
+            else if constexpr (std::is_enum_v<no_cv_t>)
+            {
+                return hash_type<std::underlying_type_t<no_cv_t>>(hash_value(hash, 7));
+            }
+            else if constexpr (is_byte_span<no_cv_t>::value
+                || rpc_hpp::detail::is_container_v<no_cv_t>)
+            {
+                return hash_type<typename no_cv_t::value_type>(hash_value(hash, 4));
+            }
+            else if constexpr (is_reflected_v<no_cv_t>)
+            {
+                // Written field by field, so the fields identify the type
+                return hash_types(
+                    hash_value(hash_value(hash, 5), count_fields<no_cv_t>()),
+                    static_cast<field_tuple_t<no_cv_t>*>(nullptr));
+            }
+            else
+            {
+                // Other objects are written by their own serialize function, which cannot be
+                // inspected, so their layout and tag stand in for it
+                uint64_t obj_hash = hash_value(hash_value(hash, 6), sizeof(no_cv_t));
+                obj_hash = hash_value(obj_hash, alignof(no_cv_t));
+
+                if constexpr (std::is_aggregate_v<no_cv_t> && !std::is_array_v<no_cv_t>)
+                {
+                    obj_hash = hash_value(obj_hash, count_fields<no_cv_t>());
+                }
+
+                return hash_value(obj_hash, bitsery_type_tag<no_cv_t>::value);
+            }
+        }
+
+        template<typename... Fields>
+        [[nodiscard]] static constexpr uint64_t hash_types(
+            uint64_t hash, [[maybe_unused]] const std::tuple<Fields...>* fields) noexcept
+        {
+            ((hash = hash_type<Fields>(hash)), ...);
+            return hash;
+        }
+
+        // Arguments are hashed as they are written, so a narrower integer can still be passed
+        // where the encoding widens it
+        template<typename R, typename... Args>
+        [[nodiscard]] static constexpr uint64_t hash_signature() noexcept
+        {
+            uint64_t hash = hash_type<R>(fnv_offset_basis);
+            ((hash = hash_type<wire_arg_t<Args>>(hash)), ...);
+            return hash_value(hash, sizeof...(Args));
+        }
+
+        // Zero if the request is too short to hold a signature
+        [[nodiscard]] static uint64_t get_signature(const bit_buffer& serial_obj) noexcept
+        {
+            size_t index = header_size;
+            size_t len = 0;
+
+            if (!read_length(serial_obj, index, len)
+                || sizeof(uint64_t) > serial_obj.size() - index - len)
+            {
+                return 0;
+            }
+
+            return read_uint64(serial_obj, index + len);
+        }
+
+        // Bitsery writes values as little-endian
+        [[nodiscard]] static uint64_t read_uint64(
+            const bit_buffer& bytes, const size_t index) noexcept
+        {
+            RPC_HPP_PRECONDITION(index + sizeof(uint64_t) <= bytes.size());
+
+            uint64_t val = 0;
+
+            for (size_t i = 0; i < sizeof(uint64_t); ++i)
+            {
+                val |= static_cast<uint64_t>(bytes[index + i]) << (8 * i);
+            }
+
+            return val;
+        }
+
+        // Checks the header without allocating, so that garbage is rejected before dispatch
+        [[nodiscard]] static bool validate_header(const bit_buffer& bytes) noexcept
+        {
+            if (bytes.size() < header_size)
+            {
+                return false;
+            }
+
+            int marker = 0;
+            memcpy(&marker, bytes.data(), sizeof(int));
+
+            size_t index = header_size;
+            size_t len = 0;
+
+            switch (marker)
+            {
+                case call_marker:
+                    // The name is followed by the signature
+                    return read_length(bytes, index, len) && len <= config::max_func_name_size
+                        && sizeof(uint64_t) <= bytes.size() - index - len;
+
+                case map_marker:
+                    return read_length(bytes, index, len) && len <= config::max_func_name_size;
+
+                case batch_marker:
+                case chain_marker:
+                    // Each call takes at least one byte, so the count is bounded by the same check
+                    return read_length(bytes, index, len) && len <= config::max_container_size;
+
+                case 0:
+                    // The body of a successful response depends on the signature of the call
+                    return true;
+
+                default:
+                    // An error response is only the header and the message
+                    return marker > 0
+                        && marker <= static_cast<int>(exception_type::server_receive)
+                        && read_length(bytes, index, len) && len <= config::max_string_size
+                        && index + len == bytes.size();
+            }
+        }
+
+        [[nodiscard]] static std::vector<std::optional<bit_buffer>> validate_calls(
+            std::vector<bit_buffer>&& calls)
+        {
+            std::vector<std::optional<bit_buffer>> validated{};
+            validated.reserve(calls.size());
+
+            for (auto& call : calls)
+            {
+                validated.push_back(
+                    validate_header(call) ? std::make_optional(std::move(call)) : std::nullopt);
+            }
+
+            return validated;
+        }
+
+        // Reads a length without reading past the end of the bytes, and checks that the data it
+        // counts fits in what remains
+        [[nodiscard]] static bool read_length(
+            const bit_buffer& bytes, size_t& index, size_t& len) noexcept
+        {
+            if (index >= bytes.size())
+            {
+                return false;
+            }
+
+            const auto hb = bytes[index];
+            const size_t len_size = hb < 0x80U ? 1 : ((hb & 0x40U) != 0U ? 4 : 2);
+
+            if (len_size > bytes.size() - index)
+            {
+                return false;
+            }
+
+            len = extract_length(bytes, index);
+            return len <= bytes.size() - index;
+        }
+
+        // Borrowed from Bitsery library for compatibility
+        static unsigned extract_length(const bit_buffer& bytes, size_t& index) noexcept
+        {
+            RPC_HPP_PRECONDITION(index < bytes.size());
+
+            const uint8_t hb = bytes[index++];
+
+            if (hb < 0x80U)
+            {
+                return hb;
+            }
 
-            bytes.insert(std::next(bytes.begin(), index++), static_cast<uint8_t>(size >> 16));
+            assert(index < bytes.size());
+            const uint8_t lb = bytes[index++];
 
-            bytes.insert(
-                std::next(bytes.begin(), index++), *reinterpret_cast<const uint8_t*>(&size));
+            if ((hb & 0x40U) != 0U)
+            {
+                // The low word is little-endian, and takes two bytes
+                assert(index + 1 < bytes.size());
+                const unsigned lw = static_cast<unsigned>(bytes[index])
+                    | (static_cast<unsigned>(bytes[index + 1]) << 8U);
+                index += 2;
+                return ((((hb & 0x3FU) << 8) | lb) << 16) | lw;
+            }
 
-            bytes.insert(
-                std::next(bytes.begin(), index++), *reinterpret_cast<const uint8_t*>(&size) + 1);
+            return ((hb & 0x7FU) << 8) | lb;
         }
     };
+
+    // The encoding used by bitsery_adapter can be picked with RPC_HPP_BITSERY_EXACT_SZ or
+    // RPC_HPP_BITSERY_COMPACT_SZ, other encodings are available through basic_bitsery_adapter
+#if defined(RPC_HPP_BITSERY_EXACT_SZ)
+    using bitsery_adapter = basic_bitsery_adapter<bitsery_config<bitsery_encoding::exact>>;
+#elif defined(RPC_HPP_BITSERY_COMPACT_SZ)
+    using bitsery_adapter = basic_bitsery_adapter<bitsery_config<bitsery_encoding::compact>>;
+#else
+    using bitsery_adapter = basic_bitsery_adapter<bitsery_config<bitsery_encoding::wide>>;
+#endif
 } // namespace adapters
 } // namespace rpc_hpp
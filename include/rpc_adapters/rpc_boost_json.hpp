@@ -40,6 +40,8 @@
 
 #include <boost/json.hpp>
 
+#include <vector>
+
 namespace rpc_hpp
 {
 namespace adapters
@@ -78,26 +80,40 @@ namespace adapters
 
             const auto& obj = val.get_object();
 
-            if (const auto ex_it = obj.find("except_type"); ex_it != obj.end())
+            if (const auto batch_it = obj.find("batch"); batch_it != obj.end())
             {
-                if (const auto& ex_val = ex_it->value();
-                    !ex_val.is_int64() || (ex_val.get_int64() != 0 && !obj.contains("err_mesg")))
+                if (!batch_it->value().is_array())
                 {
                     return std::nullopt;
                 }
 
-                // Objects with exceptions can be otherwise empty
+                // Each call in the batch is validated when the batch is split
                 return std::make_optional(std::move(obj));
             }
 
-            if (const auto fname_it = obj.find("func_name"); fname_it == obj.end()
-                || !fname_it->value().is_string() || fname_it->value().get_string().empty())
+            if (const auto chain_it = obj.find("chain"); chain_it != obj.end())
             {
-                return std::nullopt;
+                if (!chain_it->value().is_array())
+                {
+                    return std::nullopt;
+                }
+
+                // Each call in the chain is validated when the chain is split
+                return std::make_optional(std::move(obj));
+            }
+
+            if (const auto map_it = obj.find("map"); map_it != obj.end())
+            {
+                if (!map_it->value().is_array() || !validate_func_name(obj))
+                {
+                    return std::nullopt;
+                }
+
+                // Each call in the map is validated when the map is split
+                return std::make_optional(std::move(obj));
             }
 
-            if (const auto args_it = obj.find("args");
-                args_it == obj.end() || !args_it->value().is_array())
+            if (!validate_object(obj))
             {
                 return std::nullopt;
             }
@@ -108,16 +124,76 @@ namespace adapters
         static boost::json::object empty_object() { return boost::json::object{}; }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static boost::json::object serialize_pack(
-            const detail::packed_func<R, Args...>& pack)
+        [[nodiscard]] static boost::json::object serialize_request(
+            const detail::request_view<Args...>& request)
         {
             boost::json::object obj{};
-            obj["func_name"] = pack.get_func_name();
+            obj["call_id"] = request.get_call_id();
+            obj["func_name"] = request.get_func_name();
             auto& args = obj["args"].emplace_array();
             args.reserve(sizeof...(Args));
-            detail::for_each_tuple(pack.get_args(),
+            detail::for_each_tuple(request.get_args(),
+                [&args](auto&& elem) { push_args(std::forward<decltype(elem)>(elem), args); });
+
+            return obj;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static boost::json::object prepare_request(const std::string& func_name)
+        {
+            boost::json::object obj{};
+            obj["call_id"] = 0;
+            obj["func_name"] = func_name;
+            obj["args"].emplace_array();
+            return obj;
+        }
+
+        template<typename... Args>
+        [[nodiscard]] static boost::json::object serialize_prepared(
+            const boost::json::object& prepared, const detail::request_view<Args...>& request)
+        {
+            auto obj = prepared;
+            obj["call_id"] = request.get_call_id();
+            auto& args = obj["args"].as_array();
+            args.reserve(sizeof...(Args));
+            detail::for_each_tuple(request.get_args(),
                 [&args](auto&& elem) { push_args(std::forward<decltype(elem)>(elem), args); });
 
+            return obj;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_request(
+            const boost::json::object& serial_obj)
+        {
+            auto args = parse_call_args<Args...>(
+                get_args(serial_obj), detail::packed_func<R, Args...>::all_args);
+
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack(
+                    read_func_name(serial_obj), std::move(args));
+
+                pack.set_call_id(get_call_id(serial_obj));
+                return pack;
+            }
+            else
+            {
+                detail::packed_func<R, Args...> pack(
+                    read_func_name(serial_obj), std::nullopt, std::move(args));
+
+                pack.set_call_id(get_call_id(serial_obj));
+                return pack;
+            }
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static boost::json::object serialize_response(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            boost::json::object obj{};
+            obj["call_id"] = pack.get_call_id();
+
             if (!pack)
             {
                 obj["except_type"] = static_cast<int>(pack.get_except_type());
@@ -125,6 +201,15 @@ namespace adapters
                 return obj;
             }
 
+            // Only the arguments sent back are written, along with which ones they are
+            if (pack.get_arg_mask() != 0)
+            {
+                obj["arg_mask"] = pack.get_arg_mask();
+                auto& args = obj["args"].emplace_array();
+                detail::for_each_tuple(pack.get_args(), pack.get_arg_mask(),
+                    [&args](auto&& elem) { push_args(std::forward<decltype(elem)>(elem), args); });
+            }
+
             if constexpr (!std::is_void_v<R>)
             {
                 obj["result"] = {};
@@ -135,52 +220,157 @@ namespace adapters
         }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_response(
             const boost::json::object& serial_obj)
         {
-            const auto& args_val = serial_obj.at("args");
-            [[maybe_unused]] unsigned arg_counter = 0;
-            typename detail::packed_func<R, Args...>::args_t args{ parse_args<Args>(
-                args_val, arg_counter)... };
-
-            if constexpr (std::is_void_v<R>)
+            if (serial_obj.contains("except_type"))
             {
-                detail::packed_func<void, Args...> pack(
-                    serial_obj.at("func_name").get_string().c_str(), std::move(args));
-
-                if (serial_obj.contains("except_type"))
+                auto pack = []
                 {
-                    pack.set_exception(serial_obj.at("err_mesg").get_string().c_str(),
-                        static_cast<exception_type>(serial_obj.at("except_type").get_int64()));
-                }
+                    if constexpr (std::is_void_v<R>)
+                    {
+                        return detail::packed_func<void, Args...>(std::string{}, {});
+                    }
+                    else
+                    {
+                        return detail::packed_func<R, Args...>(std::string{}, std::nullopt, {});
+                    }
+                }();
+
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(0);
+                pack.set_exception(serial_obj.at("err_mesg").get_string().c_str(),
+                    static_cast<exception_type>(serial_obj.at("except_type").get_int64()));
+
+                return pack;
+            }
+
+            const auto arg_mask = get_arg_mask(serial_obj);
+            auto args = parse_call_args<Args...>(get_args(serial_obj), arg_mask);
 
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack(std::string{}, std::move(args));
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(arg_mask);
                 return pack;
             }
             else
             {
-                if (serial_obj.contains("result") && !serial_obj.at("result").is_null())
-                {
-                    return detail::packed_func<R, Args...>(
-                        serial_obj.at("func_name").get_string().c_str(),
-                        parse_arg<R>(serial_obj.at("result")), std::move(args));
-                }
-
                 detail::packed_func<R, Args...> pack(
-                    serial_obj.at("func_name").get_string().c_str(), std::nullopt, std::move(args));
-
-                if (serial_obj.contains("except_type"))
-                {
-                    pack.set_exception(serial_obj.at("err_mesg").get_string().c_str(),
-                        static_cast<exception_type>(serial_obj.at("except_type").get_int64()));
-                }
+                    std::string{}, parse_arg<R>(serial_obj.at("result")), std::move(args));
 
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(arg_mask);
                 return pack;
             }
         }
 
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<void, Args...> deserialize_response_into(
+            const boost::json::object& serial_obj, R& result)
+        {
+            auto pack = deserialize_response<void, Args...>(serial_obj);
+
+            if (pack)
+            {
+                parse_arg_into(serial_obj.at("result"), result);
+            }
+
+            return pack;
+        }
+
+        [[nodiscard]] static boost::json::object make_batch(
+            const uint64_t call_id, std::vector<boost::json::object>&& serial_objs)
+        {
+            return make_calls(call_id, "batch", std::move(serial_objs));
+        }
+
+        [[nodiscard]] static bool is_batch(const boost::json::object& serial_obj)
+        {
+            return serial_obj.contains("batch");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<boost::json::object>> split_batch(
+            boost::json::object&& serial_obj)
+        {
+            return split_calls(serial_obj, "batch");
+        }
+
+        [[nodiscard]] static boost::json::object make_map(const uint64_t call_id,
+            const std::string& func_name, std::vector<boost::json::object>&& serial_objs)
+        {
+            boost::json::object obj{};
+            obj["call_id"] = call_id;
+            obj["func_name"] = func_name;
+            auto& map_arr = obj["map"].emplace_array();
+            map_arr.reserve(serial_objs.size());
+
+            // The function name is only sent once, for the whole map
+            for (auto& serial_obj : serial_objs)
+            {
+                serial_obj.erase("func_name");
+                map_arr.emplace_back(std::move(serial_obj));
+            }
+
+            return obj;
+        }
+
+        [[nodiscard]] static bool is_map(const boost::json::object& serial_obj)
+        {
+            return serial_obj.contains("map");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<boost::json::object>> split_map(
+            boost::json::object&& serial_obj)
+        {
+            return split_calls(serial_obj, "map");
+        }
+
+        [[nodiscard]] static boost::json::object make_chain(
+            const uint64_t call_id, std::vector<boost::json::object>&& serial_objs)
+        {
+            return make_calls(call_id, "chain", std::move(serial_objs));
+        }
+
+        [[nodiscard]] static bool is_chain(const boost::json::object& serial_obj)
+        {
+            return serial_obj.contains("chain");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<boost::json::object>> split_chain(
+            boost::json::object&& serial_obj)
+        {
+            return split_calls(serial_obj, "chain");
+        }
+
+        [[nodiscard]] static uint64_t get_call_id(const boost::json::object& serial_obj)
+        {
+            const auto id_it = serial_obj.find("call_id");
+
+            if (id_it == serial_obj.end())
+            {
+                return 0;
+            }
+
+            const auto& id_val = id_it->value();
+
+            if (id_val.is_uint64())
+            {
+                return id_val.get_uint64();
+            }
+
+            if (id_val.is_int64() && id_val.get_int64() > 0)
+            {
+                return static_cast<uint64_t>(id_val.get_int64());
+            }
+
+            return 0;
+        }
+
         [[nodiscard]] static std::string get_func_name(const boost::json::object& serial_obj)
         {
-            return  serial_obj.at("func_name").get_string().c_str();
+            return read_func_name(serial_obj);
         }
 
         [[nodiscard]] static rpc_exception extract_exception(const boost::json::object& serial_obj)
@@ -191,8 +381,12 @@ namespace adapters
 
         static void set_exception(boost::json::object& serial_obj, const rpc_exception& ex)
         {
-            serial_obj["except_type"] = static_cast<int>(ex.get_type());
-            serial_obj["err_mesg"] = boost::json::string{ ex.what() };
+            // Error responses only carry the error, not the rest of the call
+            boost::json::object err_obj{};
+            err_obj["call_id"] = get_call_id(serial_obj);
+            err_obj["except_type"] = static_cast<int>(ex.get_type());
+            err_obj["err_mesg"] = boost::json::string{ ex.what() };
+            serial_obj = std::move(err_obj);
         }
 
         template<typename T>
@@ -202,6 +396,103 @@ namespace adapters
         static T deserialize(const boost::json::object& serial_obj) = delete;
 
     private:
+        [[nodiscard]] static boost::json::object make_calls(const uint64_t call_id,
+            const boost::json::string_view key, std::vector<boost::json::object>&& serial_objs)
+        {
+            boost::json::object obj{};
+            obj["call_id"] = call_id;
+            auto& call_arr = obj[key].emplace_array();
+            call_arr.reserve(serial_objs.size());
+
+            for (auto& serial_obj : serial_objs)
+            {
+                call_arr.emplace_back(std::move(serial_obj));
+            }
+
+            return obj;
+        }
+
+        [[nodiscard]] static std::vector<std::optional<boost::json::object>> split_calls(
+            boost::json::object& serial_obj, const boost::json::string_view key)
+        {
+            auto& call_arr = serial_obj.at(key).as_array();
+            std::vector<std::optional<boost::json::object>> serial_objs{};
+            serial_objs.reserve(call_arr.size());
+
+            for (auto& val : call_arr)
+            {
+                if (val.is_object() && validate_object(val.get_object()))
+                {
+                    serial_objs.emplace_back(std::move(val.get_object()));
+                }
+                else
+                {
+                    serial_objs.emplace_back(std::nullopt);
+                }
+            }
+
+            return serial_objs;
+        }
+
+        // nodiscard because this function is pointless without checking the bool
+        [[nodiscard]] static bool validate_object(const boost::json::object& obj)
+        {
+            if (const auto ex_it = obj.find("except_type"); ex_it != obj.end())
+            {
+                // Objects with exceptions can be otherwise empty
+                const auto& ex_val = ex_it->value();
+                return ex_val.is_int64() && (ex_val.get_int64() == 0 || obj.contains("err_mesg"));
+            }
+
+            // Responses and calls within a map are not named
+            if (obj.contains("func_name") && !validate_func_name(obj))
+            {
+                return false;
+            }
+
+            // Responses leave out the arguments when none are sent back
+            const auto args_it = obj.find("args");
+            return args_it == obj.end() || args_it->value().is_array();
+        }
+
+        // nodiscard because this function is pointless without checking the bool
+        [[nodiscard]] static bool validate_func_name(const boost::json::object& obj)
+        {
+            const auto fname_it = obj.find("func_name");
+            return fname_it != obj.end() && fname_it->value().is_string()
+                && !fname_it->value().get_string().empty();
+        }
+
+        [[nodiscard]] static const boost::json::value& get_args(
+            const boost::json::object& serial_obj)
+        {
+            static const boost::json::value no_args = boost::json::array{};
+            const auto args_it = serial_obj.find("args");
+            return args_it != serial_obj.end() ? args_it->value() : no_args;
+        }
+
+        // Responses leave out the mask when no arguments are sent back
+        [[nodiscard]] static uint64_t get_arg_mask(const boost::json::object& serial_obj)
+        {
+            const auto mask_it = serial_obj.find("arg_mask");
+
+            if (mask_it == serial_obj.end())
+            {
+                return 0;
+            }
+
+            const auto& mask_val = mask_it->value();
+            return mask_val.is_uint64() ? mask_val.get_uint64()
+                                        : static_cast<uint64_t>(mask_val.as_int64());
+        }
+
+        [[nodiscard]] static std::string read_func_name(const boost::json::object& serial_obj)
+        {
+            const auto fname_it = serial_obj.find("func_name");
+            return fname_it != serial_obj.end() ? fname_it->value().get_string().c_str()
+                                                : std::string{};
+        }
+
         template<typename T>
         [[nodiscard]] static constexpr bool validate_arg(const boost::json::value& arg) noexcept
         {
@@ -352,6 +643,45 @@ namespace adapters
             }
         }
 
+        // Strings and containers keep the storage out already holds
+        template<typename T>
+        static void parse_arg_into(const boost::json::value& arg, T& out)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                if (!validate_arg<T>(arg))
+                {
+                    throw function_mismatch(mismatch_string(typeid(T).name(), arg));
+                }
+
+                const auto& str = arg.get_string();
+                out.assign(str.data(), str.size());
+            }
+            else if constexpr (rpc_hpp::detail::is_container_v<T>)
+            {
+                using subvalue_t = typename T::value_type;
+
+                if (!validate_arg<T>(arg))
+                {
+                    throw function_mismatch(mismatch_string(typeid(T).name(), arg));
+                }
+
+                const auto& arr = arg.get_array();
+                out.clear();
+                out.reserve(arr.size());
+                unsigned arg_counter = 0;
+
+                for (const auto& val : arr)
+                {
+                    out.push_back(parse_args<subvalue_t>(val, arg_counter));
+                }
+            }
+            else
+            {
+                out = parse_arg<T>(arg);
+            }
+        }
+
         template<typename T>
         [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
             const boost::json::value& arg_arr, unsigned& index)
@@ -370,6 +700,40 @@ namespace adapters
 
             return parse_arg<T>(arr[index++]);
         }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename... Args>
+        [[nodiscard]] static std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>
+            parse_call_args(
+                const boost::json::value& args_val, [[maybe_unused]] const uint64_t arg_mask)
+        {
+            [[maybe_unused]] size_t arg_index = 0;
+            [[maybe_unused]] unsigned arg_counter = 0;
+            std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...> args{
+                parse_masked_arg<Args>(args_val, arg_mask, arg_index, arg_counter)...
+            };
+
+            if (args_val.is_array() && args_val.get_array().size() > arg_counter)
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            return args;
+        }
+
+        // Arguments left out of a response are default constructed (and never assigned back)
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_masked_arg(
+            const boost::json::value& arg_arr, const uint64_t arg_mask, size_t& arg_index,
+            unsigned& index)
+        {
+            if (((arg_mask >> arg_index++) & 1U) == 0)
+            {
+                return {};
+            }
+
+            return parse_args<T>(arg_arr, index);
+        }
     };
 } // namespace adapters
 } // namespace rpc_hpp
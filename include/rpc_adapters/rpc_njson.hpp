@@ -40,6 +40,9 @@
 
 #include <nlohmann/json.hpp>
 
+#include <iterator>
+#include <vector>
+
 namespace rpc_hpp
 {
 namespace adapters
@@ -79,24 +82,40 @@ namespace adapters
                 return std::nullopt;
             }
 
-            if (obj.contains("except_type"))
+            if (const auto batch_it = obj.find("batch"); batch_it != obj.end())
             {
-                if (obj["except_type"] != 0 && !obj.contains("err_mesg"))
+                if (!batch_it->is_array())
                 {
                     return std::nullopt;
                 }
 
-                // Objects with exceptions can be otherwise empty
+                // Each call in the batch is validated when the batch is split
                 return std::make_optional(std::move(obj));
             }
 
-            if (const auto fname_it = obj.find("func_name");
-                fname_it == obj.end() || !fname_it->is_string() || fname_it->empty())
+            if (const auto chain_it = obj.find("chain"); chain_it != obj.end())
             {
-                return std::nullopt;
+                if (!chain_it->is_array())
+                {
+                    return std::nullopt;
+                }
+
+                // Each call in the chain is validated when the chain is split
+                return std::make_optional(std::move(obj));
+            }
+
+            if (const auto map_it = obj.find("map"); map_it != obj.end())
+            {
+                if (!map_it->is_array() || !validate_func_name(obj))
+                {
+                    return std::nullopt;
+                }
+
+                // Each call in the map is validated when the map is split
+                return std::make_optional(std::move(obj));
             }
 
-            if (const auto args_it = obj.find("args"); args_it == obj.end() || !args_it->is_array())
+            if (!validate_object(obj))
             {
                 return std::nullopt;
             }
@@ -107,19 +126,81 @@ namespace adapters
         static nlohmann::json empty_object() { return nlohmann::json::object(); }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static nlohmann::json serialize_pack(
-            const detail::packed_func<R, Args...>& pack)
+        [[nodiscard]] static nlohmann::json serialize_request(
+            const detail::request_view<Args...>& request)
         {
             nlohmann::json obj{};
-            obj["func_name"] = pack.get_func_name();
+            obj["call_id"] = request.get_call_id();
+            obj["func_name"] = request.get_func_name();
             obj["args"] = nlohmann::json::array();
             auto& arg_arr = obj["args"];
             arg_arr.get_ref<nlohmann::json::array_t&>().reserve(sizeof...(Args));
 
-            detail::for_each_tuple(pack.get_args(),
+            detail::for_each_tuple(request.get_args(),
                 [&arg_arr](auto&& elem)
                 { push_args(std::forward<decltype(elem)>(elem), arg_arr); });
 
+            return obj;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static nlohmann::json prepare_request(const std::string& func_name)
+        {
+            nlohmann::json obj{};
+            obj["call_id"] = 0;
+            obj["func_name"] = func_name;
+            obj["args"] = nlohmann::json::array();
+            return obj;
+        }
+
+        template<typename... Args>
+        [[nodiscard]] static nlohmann::json serialize_prepared(
+            const nlohmann::json& prepared, const detail::request_view<Args...>& request)
+        {
+            auto obj = prepared;
+            obj["call_id"] = request.get_call_id();
+            auto& arg_arr = obj["args"];
+            arg_arr.get_ref<nlohmann::json::array_t&>().reserve(sizeof...(Args));
+
+            detail::for_each_tuple(request.get_args(),
+                [&arg_arr](auto&& elem)
+                { push_args(std::forward<decltype(elem)>(elem), arg_arr); });
+
+            return obj;
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_request(
+            const nlohmann::json& serial_obj)
+        {
+            auto args = parse_call_args<Args...>(
+                get_args(serial_obj), detail::packed_func<R, Args...>::all_args);
+
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack(
+                    read_func_name(serial_obj), std::move(args));
+
+                pack.set_call_id(get_call_id(serial_obj));
+                return pack;
+            }
+            else
+            {
+                detail::packed_func<R, Args...> pack(
+                    read_func_name(serial_obj), std::nullopt, std::move(args));
+
+                pack.set_call_id(get_call_id(serial_obj));
+                return pack;
+            }
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static nlohmann::json serialize_response(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            nlohmann::json obj{};
+            obj["call_id"] = pack.get_call_id();
+
             if (!pack)
             {
                 obj["except_type"] = pack.get_except_type();
@@ -127,6 +208,18 @@ namespace adapters
                 return obj;
             }
 
+            // Only the arguments sent back are written, along with which ones they are
+            if (pack.get_arg_mask() != 0)
+            {
+                obj["arg_mask"] = pack.get_arg_mask();
+                obj["args"] = nlohmann::json::array();
+                auto& arg_arr = obj["args"];
+
+                detail::for_each_tuple(pack.get_args(), pack.get_arg_mask(),
+                    [&arg_arr](auto&& elem)
+                    { push_args(std::forward<decltype(elem)>(elem), arg_arr); });
+            }
+
             if constexpr (!std::is_void_v<R>)
             {
                 obj["result"] = {};
@@ -137,50 +230,142 @@ namespace adapters
         }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_response(
             const nlohmann::json& serial_obj)
         {
-            const auto& args_val = serial_obj["args"];
-            [[maybe_unused]] unsigned arg_counter = 0;
-            typename detail::packed_func<R, Args...>::args_t args{ parse_args<Args>(
-                args_val, arg_counter)... };
-
-            if constexpr (std::is_void_v<R>)
+            if (serial_obj.contains("except_type"))
             {
-                detail::packed_func<void, Args...> pack(serial_obj["func_name"], std::move(args));
-
-                if (serial_obj.contains("except_type"))
+                auto pack = []
                 {
-                    pack.set_exception(serial_obj["err_mesg"],
-                        static_cast<exception_type>(serial_obj["except_type"]));
-                }
+                    if constexpr (std::is_void_v<R>)
+                    {
+                        return detail::packed_func<void, Args...>(std::string{}, {});
+                    }
+                    else
+                    {
+                        return detail::packed_func<R, Args...>(std::string{}, std::nullopt, {});
+                    }
+                }();
+
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(0);
+                pack.set_exception(serial_obj["err_mesg"],
+                    static_cast<exception_type>(serial_obj["except_type"]));
 
                 return pack;
             }
+
+            const auto arg_mask = serial_obj.value("arg_mask", uint64_t{});
+            auto args = parse_call_args<Args...>(get_args(serial_obj), arg_mask);
+
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack(std::string{}, std::move(args));
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(arg_mask);
+                return pack;
+            }
             else
             {
-                if (serial_obj.contains("result") && !serial_obj["result"].is_null())
-                {
-                    return detail::packed_func<R, Args...>(serial_obj["func_name"],
-                        parse_arg<R>(serial_obj["result"]), std::move(args));
-                }
-
                 detail::packed_func<R, Args...> pack(
-                    serial_obj["func_name"], std::nullopt, std::move(args));
-
-                if (serial_obj.contains("except_type"))
-                {
-                    pack.set_exception(serial_obj["err_mesg"],
-                        static_cast<exception_type>(serial_obj["except_type"]));
-                }
+                    std::string{}, parse_arg<R>(serial_obj.at("result")), std::move(args));
 
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(arg_mask);
                 return pack;
             }
         }
 
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<void, Args...> deserialize_response_into(
+            const nlohmann::json& serial_obj, R& result)
+        {
+            auto pack = deserialize_response<void, Args...>(serial_obj);
+
+            if (pack)
+            {
+                parse_arg_into(serial_obj.at("result"), result);
+            }
+
+            return pack;
+        }
+
+        [[nodiscard]] static nlohmann::json make_batch(
+            const uint64_t call_id, std::vector<nlohmann::json>&& serial_objs)
+        {
+            return make_calls(call_id, "batch", std::move(serial_objs));
+        }
+
+        [[nodiscard]] static bool is_batch(const nlohmann::json& serial_obj)
+        {
+            return serial_obj.contains("batch");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<nlohmann::json>> split_batch(
+            nlohmann::json&& serial_obj)
+        {
+            return split_calls(serial_obj, "batch");
+        }
+
+        [[nodiscard]] static nlohmann::json make_map(const uint64_t call_id,
+            const std::string& func_name, std::vector<nlohmann::json>&& serial_objs)
+        {
+            nlohmann::json obj{};
+            obj["call_id"] = call_id;
+            obj["func_name"] = func_name;
+            obj["map"] = nlohmann::json::array();
+            auto& map_arr = obj["map"].get_ref<nlohmann::json::array_t&>();
+            map_arr.reserve(serial_objs.size());
+
+            // The function name is only sent once, for the whole map
+            for (auto& serial_obj : serial_objs)
+            {
+                serial_obj.erase("func_name");
+                map_arr.push_back(std::move(serial_obj));
+            }
+
+            return obj;
+        }
+
+        [[nodiscard]] static bool is_map(const nlohmann::json& serial_obj)
+        {
+            return serial_obj.contains("map");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<nlohmann::json>> split_map(
+            nlohmann::json&& serial_obj)
+        {
+            return split_calls(serial_obj, "map");
+        }
+
+        [[nodiscard]] static nlohmann::json make_chain(
+            const uint64_t call_id, std::vector<nlohmann::json>&& serial_objs)
+        {
+            return make_calls(call_id, "chain", std::move(serial_objs));
+        }
+
+        [[nodiscard]] static bool is_chain(const nlohmann::json& serial_obj)
+        {
+            return serial_obj.contains("chain");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<nlohmann::json>> split_chain(
+            nlohmann::json&& serial_obj)
+        {
+            return split_calls(serial_obj, "chain");
+        }
+
+        [[nodiscard]] static uint64_t get_call_id(const nlohmann::json& serial_obj)
+        {
+            const auto id_it = serial_obj.find("call_id");
+            return id_it != serial_obj.end() && id_it->is_number_unsigned() ? id_it->get<uint64_t>()
+                                                                           : 0;
+        }
+
         [[nodiscard]] static std::string get_func_name(const nlohmann::json& serial_obj)
         {
-            return serial_obj["func_name"];
+            return read_func_name(serial_obj);
         }
 
         [[nodiscard]] static rpc_exception extract_exception(const nlohmann::json& serial_obj)
@@ -191,8 +376,12 @@ namespace adapters
 
         static void set_exception(nlohmann::json& serial_obj, const rpc_exception& ex)
         {
-            serial_obj["except_type"] = ex.get_type();
-            serial_obj["err_mesg"] = ex.what();
+            // Error responses only carry the error, not the rest of the call
+            nlohmann::json err_obj{};
+            err_obj["call_id"] = get_call_id(serial_obj);
+            err_obj["except_type"] = ex.get_type();
+            err_obj["err_mesg"] = ex.what();
+            serial_obj = std::move(err_obj);
         }
 
         template<typename T>
@@ -202,6 +391,79 @@ namespace adapters
         static T deserialize(const nlohmann::json& serial_obj) = delete;
 
     private:
+        [[nodiscard]] static nlohmann::json make_calls(const uint64_t call_id,
+            const char* const key, std::vector<nlohmann::json>&& serial_objs)
+        {
+            nlohmann::json obj{};
+            obj["call_id"] = call_id;
+            obj[key] = nlohmann::json::array_t(std::make_move_iterator(serial_objs.begin()),
+                std::make_move_iterator(serial_objs.end()));
+
+            return obj;
+        }
+
+        [[nodiscard]] static std::vector<std::optional<nlohmann::json>> split_calls(
+            nlohmann::json& serial_obj, const char* const key)
+        {
+            auto& call_arr = serial_obj[key].get_ref<nlohmann::json::array_t&>();
+            std::vector<std::optional<nlohmann::json>> serial_objs{};
+            serial_objs.reserve(call_arr.size());
+
+            for (auto& obj : call_arr)
+            {
+                if (obj.is_object() && validate_object(obj))
+                {
+                    serial_objs.emplace_back(std::move(obj));
+                }
+                else
+                {
+                    serial_objs.emplace_back(std::nullopt);
+                }
+            }
+
+            return serial_objs;
+        }
+
+        // nodiscard because this function is pointless without checking the bool
+        [[nodiscard]] static bool validate_object(const nlohmann::json& obj)
+        {
+            if (const auto ex_it = obj.find("except_type"); ex_it != obj.end())
+            {
+                // Objects with exceptions can be otherwise empty
+                return *ex_it == 0 || obj.contains("err_mesg");
+            }
+
+            // Responses and calls within a map are not named
+            if (obj.contains("func_name") && !validate_func_name(obj))
+            {
+                return false;
+            }
+
+            // Responses leave out the arguments when none are sent back
+            const auto args_it = obj.find("args");
+            return args_it == obj.end() || args_it->is_array();
+        }
+
+        // nodiscard because this function is pointless without checking the bool
+        [[nodiscard]] static bool validate_func_name(const nlohmann::json& obj)
+        {
+            const auto fname_it = obj.find("func_name");
+            return fname_it != obj.end() && fname_it->is_string() && !fname_it->empty();
+        }
+
+        [[nodiscard]] static const nlohmann::json& get_args(const nlohmann::json& serial_obj)
+        {
+            static const nlohmann::json no_args = nlohmann::json::array();
+            const auto args_it = serial_obj.find("args");
+            return args_it != serial_obj.end() ? *args_it : no_args;
+        }
+
+        [[nodiscard]] static std::string read_func_name(const nlohmann::json& serial_obj)
+        {
+            const auto fname_it = serial_obj.find("func_name");
+            return fname_it != serial_obj.end() ? fname_it->get<std::string>() : std::string{};
+        }
+
         // nodiscard because this function is pointless without checking the bool
         template<typename T>
         [[nodiscard]] static constexpr bool validate_arg(const nlohmann::json& arg) noexcept
@@ -318,6 +580,43 @@ namespace adapters
             }
         }
 
+        // Strings and containers keep the storage out already holds
+        template<typename T>
+        static void parse_arg_into(const nlohmann::json& arg, T& out)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                if (!validate_arg<T>(arg))
+                {
+                    throw function_mismatch(mismatch_string(typeid(T).name(), arg));
+                }
+
+                out.assign(arg.get_ref<const std::string&>());
+            }
+            else if constexpr (detail::is_container_v<T>)
+            {
+                using value_t = typename T::value_type;
+
+                if (!validate_arg<T>(arg))
+                {
+                    throw function_mismatch(mismatch_string(typeid(T).name(), arg));
+                }
+
+                out.clear();
+                out.reserve(arg.size());
+                unsigned arg_counter = 0;
+
+                for (const auto& val : arg)
+                {
+                    out.push_back(parse_args<value_t>(val, arg_counter));
+                }
+            }
+            else
+            {
+                out = parse_arg<T>(arg);
+            }
+        }
+
         // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
         template<typename T>
         [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
@@ -331,6 +630,40 @@ namespace adapters
             const auto& arg = arg_arr.is_array() ? arg_arr[index++] : arg_arr;
             return parse_arg<T>(arg);
         }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename... Args>
+        [[nodiscard]] static std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>
+            parse_call_args(
+                const nlohmann::json& args_val, [[maybe_unused]] const uint64_t arg_mask)
+        {
+            [[maybe_unused]] size_t arg_index = 0;
+            [[maybe_unused]] unsigned arg_counter = 0;
+            std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...> args{
+                parse_masked_arg<Args>(args_val, arg_mask, arg_index, arg_counter)...
+            };
+
+            if (args_val.is_array() && args_val.size() > arg_counter)
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            return args;
+        }
+
+        // Arguments left out of a response are default constructed (and never assigned back)
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_masked_arg(
+            const nlohmann::json& arg_arr, const uint64_t arg_mask, size_t& arg_index,
+            unsigned& index)
+        {
+            if (((arg_mask >> arg_index++) & 1U) == 0)
+            {
+                return {};
+            }
+
+            return parse_args<T>(arg_arr, index);
+        }
     };
 } // namespace adapters
 } // namespace rpc_hpp
@@ -42,6 +42,8 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <vector>
+
 namespace rpc_hpp
 {
 namespace adapters
@@ -77,26 +79,45 @@ namespace adapters
                 return std::nullopt;
             }
 
-            if (const auto ex_it = d.FindMember("except_type"); ex_it != d.MemberEnd())
+            if (!d.IsObject())
+            {
+                return std::nullopt;
+            }
+
+            if (const auto batch_it = d.FindMember("batch"); batch_it != d.MemberEnd())
             {
-                if (const auto& ex_val = ex_it->value;
-                    !ex_val.IsInt() || (ex_val.GetInt() != 0 && !d.HasMember("err_mesg")))
+                if (!batch_it->value.IsArray())
                 {
                     return std::nullopt;
                 }
 
-                // Objects with exceptions can be otherwise empty
+                // Each call in the batch is validated when the batch is split
                 return std::make_optional(std::move(d));
             }
 
-            if (const auto fname_it = d.FindMember("func_name"); fname_it == d.MemberEnd()
-                || !fname_it->value.IsString() || fname_it->value.GetStringLength() == 0)
+            if (const auto chain_it = d.FindMember("chain"); chain_it != d.MemberEnd())
             {
-                return std::nullopt;
+                if (!chain_it->value.IsArray())
+                {
+                    return std::nullopt;
+                }
+
+                // Each call in the chain is validated when the chain is split
+                return std::make_optional(std::move(d));
+            }
+
+            if (const auto map_it = d.FindMember("map"); map_it != d.MemberEnd())
+            {
+                if (!map_it->value.IsArray() || !validate_func_name(d))
+                {
+                    return std::nullopt;
+                }
+
+                // Each call in the map is validated when the map is split
+                return std::make_optional(std::move(d));
             }
 
-            if (const auto args_it = d.FindMember("args");
-                args_it == d.MemberEnd() || !args_it->value.IsArray())
+            if (!validate_object(d))
             {
                 return std::nullopt;
             }
@@ -112,114 +133,279 @@ namespace adapters
         }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static rapidjson::Document serialize_pack(
-            const detail::packed_func<R, Args...>& pack)
+        [[nodiscard]] static rapidjson::Document serialize_request(
+            const detail::request_view<Args...>& request)
         {
             rapidjson::Document d{};
             auto& alloc = d.GetAllocator();
             d.SetObject();
+            d.AddMember("call_id", request.get_call_id(), alloc);
             d.AddMember("func_name",
-                rapidjson::Value{}.SetString(pack.get_func_name().c_str(), alloc), alloc);
+                rapidjson::Value{}.SetString(request.get_func_name().c_str(), alloc), alloc);
 
-            if constexpr (!std::is_void_v<R>)
-            {
-                rapidjson::Value result{};
+            rapidjson::Value args{};
+            args.SetArray();
+            args.Reserve(static_cast<rapidjson::SizeType>(sizeof...(Args)), alloc);
+            detail::for_each_tuple(request.get_args(),
+                [&args, &alloc](auto&& elem)
+                { push_args(std::forward<decltype(elem)>(elem), args, alloc); });
 
-                if (pack)
-                {
-                    if constexpr (std::is_arithmetic_v<R>)
-                    {
-                        result.Set<R>(pack.get_result());
-                    }
-                    else if constexpr (std::is_same_v<R, std::string>)
-                    {
-                        result.SetString(pack.get_result().c_str(), alloc);
-                    }
-                    else if constexpr (rpc_hpp::detail::is_container_v<R>)
-                    {
-                        const auto& container = pack.get_result();
-                        result.SetArray();
-                        result.Reserve(static_cast<rapidjson::SizeType>(container.size()), alloc);
-
-                        for (const auto& val : container)
-                        {
-                            result.PushBack(val, alloc);
-                        }
-                    }
-                    else if constexpr (rpc_hpp::detail::is_serializable_v<rapidjson_adapter, R>)
-                    {
-                        const rapidjson::Document tmp =
-                            R::template serialize<rapidjson_adapter>(pack.get_result());
+            d.AddMember("args", std::move(args), alloc);
+            return d;
+        }
 
-                        result.CopyFrom(tmp, alloc);
-                    }
-                    else
-                    {
-                        result = serialize<R>(pack.get_result(), alloc);
-                    }
-                }
+        template<typename R, typename... Args>
+        [[nodiscard]] static rapidjson::Document prepare_request(const std::string& func_name)
+        {
+            rapidjson::Document d{};
+            auto& alloc = d.GetAllocator();
+            d.SetObject();
+            d.AddMember("call_id", uint64_t{}, alloc);
+            d.AddMember("func_name", rapidjson::Value{}.SetString(func_name.c_str(), alloc), alloc);
+            d.AddMember("args", rapidjson::Value{}.SetArray(), alloc);
+            return d;
+        }
 
-                d.AddMember("result", result, alloc);
-            }
+        template<typename... Args>
+        [[nodiscard]] static rapidjson::Document serialize_prepared(
+            const rapidjson::Document& prepared, const detail::request_view<Args...>& request)
+        {
+            rapidjson::Document d{};
+            auto& alloc = d.GetAllocator();
+            d.CopyFrom(prepared, alloc);
+            d["call_id"].SetUint64(request.get_call_id());
 
-            rapidjson::Value args{};
-            args.SetArray();
+            auto& args = d["args"];
             args.Reserve(static_cast<rapidjson::SizeType>(sizeof...(Args)), alloc);
-            detail::for_each_tuple(pack.get_args(),
+            detail::for_each_tuple(request.get_args(),
                 [&args, &alloc](auto&& elem)
                 { push_args(std::forward<decltype(elem)>(elem), args, alloc); });
 
-            d.AddMember("args", std::move(args), alloc);
             return d;
         }
 
         template<typename R, typename... Args>
-        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_pack(
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_request(
             const rapidjson::Document& serial_obj)
         {
-            const auto& args_val = serial_obj["args"];
-            [[maybe_unused]] unsigned arg_counter = 0;
-            typename detail::packed_func<R, Args...>::args_t args{ parse_args<Args>(
-                args_val, arg_counter)... };
+            auto args = parse_call_args<Args...>(
+                get_args(serial_obj), detail::packed_func<R, Args...>::all_args);
 
             if constexpr (std::is_void_v<R>)
             {
                 detail::packed_func<void, Args...> pack(
-                    serial_obj["func_name"].GetString(), std::move(args));
+                    read_func_name(serial_obj), std::move(args));
+
+                pack.set_call_id(get_call_id(serial_obj));
+                return pack;
+            }
+            else
+            {
+                detail::packed_func<R, Args...> pack(
+                    read_func_name(serial_obj), std::nullopt, std::move(args));
+
+                pack.set_call_id(get_call_id(serial_obj));
+                return pack;
+            }
+        }
+
+        template<typename R, typename... Args>
+        [[nodiscard]] static rapidjson::Document serialize_response(
+            const detail::packed_func<R, Args...>& pack)
+        {
+            rapidjson::Document d{};
+            auto& alloc = d.GetAllocator();
+            d.SetObject();
+            d.AddMember("call_id", pack.get_call_id(), alloc);
+
+            if (!pack)
+            {
+                d.AddMember("except_type", static_cast<int>(pack.get_except_type()), alloc);
+                d.AddMember("err_mesg",
+                    rapidjson::Value{}.SetString(pack.get_err_mesg().c_str(), alloc), alloc);
+
+                return d;
+            }
+
+            if constexpr (!std::is_void_v<R>)
+            {
+                d.AddMember("result", make_result(pack.get_result(), alloc), alloc);
+            }
+
+            // Only the arguments sent back are written, along with which ones they are
+            if (pack.get_arg_mask() != 0)
+            {
+                rapidjson::Value args{};
+                args.SetArray();
+                detail::for_each_tuple(pack.get_args(), pack.get_arg_mask(),
+                    [&args, &alloc](auto&& elem)
+                    { push_args(std::forward<decltype(elem)>(elem), args, alloc); });
+
+                d.AddMember("arg_mask", pack.get_arg_mask(), alloc);
+                d.AddMember("args", std::move(args), alloc);
+            }
+
+            return d;
+        }
 
-                if (serial_obj.HasMember("except_type"))
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<R, Args...> deserialize_response(
+            const rapidjson::Document& serial_obj)
+        {
+            if (serial_obj.HasMember("except_type"))
+            {
+                auto pack = []
                 {
-                    pack.set_exception(serial_obj["err_mesg"].GetString(),
-                        static_cast<exception_type>(serial_obj["except_type"].GetInt()));
-                }
+                    if constexpr (std::is_void_v<R>)
+                    {
+                        return detail::packed_func<void, Args...>(std::string{}, {});
+                    }
+                    else
+                    {
+                        return detail::packed_func<R, Args...>(std::string{}, std::nullopt, {});
+                    }
+                }();
+
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(0);
+                pack.set_exception(serial_obj["err_mesg"].GetString(),
+                    static_cast<exception_type>(serial_obj["except_type"].GetInt()));
 
                 return pack;
             }
+
+            const auto arg_mask = get_arg_mask(serial_obj);
+            auto args = parse_call_args<Args...>(get_args(serial_obj), arg_mask);
+
+            if constexpr (std::is_void_v<R>)
+            {
+                detail::packed_func<void, Args...> pack(std::string{}, std::move(args));
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(arg_mask);
+                return pack;
+            }
             else
             {
-                if (serial_obj.HasMember("result") && !serial_obj["result"].IsNull())
+                const auto result_it = serial_obj.FindMember("result");
+
+                if (result_it == serial_obj.MemberEnd())
                 {
-                    const rapidjson::Value& result = serial_obj["result"];
-                    return detail::packed_func<R, Args...>(
-                        serial_obj["func_name"].GetString(), parse_arg<R>(result), std::move(args));
+                    throw deserialization_error("Response is missing its result");
                 }
 
                 detail::packed_func<R, Args...> pack(
-                    serial_obj["func_name"].GetString(), std::nullopt, std::move(args));
+                    std::string{}, parse_arg<R>(result_it->value), std::move(args));
+
+                pack.set_call_id(get_call_id(serial_obj));
+                pack.set_arg_mask(arg_mask);
+                return pack;
+            }
+        }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename R, typename... Args>
+        [[nodiscard]] static detail::packed_func<void, Args...> deserialize_response_into(
+            const rapidjson::Document& serial_obj, R& result)
+        {
+            auto pack = deserialize_response<void, Args...>(serial_obj);
 
-                if (serial_obj.HasMember("except_type"))
+            if (pack)
+            {
+                const auto result_it = serial_obj.FindMember("result");
+
+                if (result_it == serial_obj.MemberEnd())
                 {
-                    pack.set_exception(serial_obj["err_mesg"].GetString(),
-                        static_cast<exception_type>(serial_obj["except_type"].GetInt()));
+                    throw deserialization_error("Response is missing its result");
                 }
 
-                return pack;
+                parse_arg_into(result_it->value, result);
             }
+
+            return pack;
+        }
+
+        [[nodiscard]] static rapidjson::Document make_batch(
+            const uint64_t call_id, std::vector<rapidjson::Document>&& serial_objs)
+        {
+            return make_calls(call_id, "batch", std::move(serial_objs));
+        }
+
+        [[nodiscard]] static bool is_batch(const rapidjson::Document& serial_obj)
+        {
+            return serial_obj.HasMember("batch");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<rapidjson::Document>> split_batch(
+            rapidjson::Document&& serial_obj)
+        {
+            return split_calls(serial_obj, "batch");
+        }
+
+        [[nodiscard]] static rapidjson::Document make_map(const uint64_t call_id,
+            const std::string& func_name, std::vector<rapidjson::Document>&& serial_objs)
+        {
+            rapidjson::Document d{};
+            auto& alloc = d.GetAllocator();
+            d.SetObject();
+            d.AddMember("call_id", call_id, alloc);
+            d.AddMember("func_name", rapidjson::Value{}.SetString(func_name.c_str(), alloc), alloc);
+
+            rapidjson::Value map_arr{};
+            map_arr.SetArray();
+            map_arr.Reserve(static_cast<rapidjson::SizeType>(serial_objs.size()), alloc);
+
+            // The function name is only sent once, for the whole map
+            for (auto& serial_obj : serial_objs)
+            {
+                serial_obj.RemoveMember("func_name");
+                rapidjson::Value val{};
+                val.CopyFrom(serial_obj, alloc);
+                map_arr.PushBack(std::move(val), alloc);
+            }
+
+            d.AddMember("map", std::move(map_arr), alloc);
+            return d;
+        }
+
+        [[nodiscard]] static bool is_map(const rapidjson::Document& serial_obj)
+        {
+            return serial_obj.HasMember("map");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<rapidjson::Document>> split_map(
+            rapidjson::Document&& serial_obj)
+        {
+            return split_calls(serial_obj, "map");
+        }
+
+        [[nodiscard]] static rapidjson::Document make_chain(
+            const uint64_t call_id, std::vector<rapidjson::Document>&& serial_objs)
+        {
+            return make_calls(call_id, "chain", std::move(serial_objs));
+        }
+
+        [[nodiscard]] static bool is_chain(const rapidjson::Document& serial_obj)
+        {
+            return serial_obj.HasMember("chain");
+        }
+
+        [[nodiscard]] static std::vector<std::optional<rapidjson::Document>> split_chain(
+            rapidjson::Document&& serial_obj)
+        {
+            return split_calls(serial_obj, "chain");
+        }
+
+        [[nodiscard]] static uint64_t get_call_id(const rapidjson::Document& serial_obj)
+        {
+            const auto id_it = serial_obj.FindMember("call_id");
+            return id_it != serial_obj.MemberEnd() && id_it->value.IsUint64()
+                ? id_it->value.GetUint64()
+                : 0;
         }
 
         [[nodiscard]] static std::string get_func_name(const rapidjson::Document& serial_obj)
         {
-            return serial_obj["func_name"].GetString();
+            return read_func_name(serial_obj);
         }
 
         [[nodiscard]] static rpc_exception extract_exception(const rapidjson::Document& serial_obj)
@@ -230,20 +416,14 @@ namespace adapters
 
         static void set_exception(rapidjson::Document& serial_obj, const rpc_exception& ex)
         {
-            auto& alloc = serial_obj.GetAllocator();
-
-            if (const auto ex_it = serial_obj.FindMember("except_type");
-                ex_it != serial_obj.MemberEnd())
-            {
-                ex_it->value.SetInt(static_cast<int>(ex.get_type()));
-                serial_obj["err_mesg"].SetString(ex.what(), alloc);
-            }
-            else
-            {
-                serial_obj.AddMember("except_type", static_cast<int>(ex.get_type()), alloc);
-                serial_obj.AddMember(
-                    "err_mesg", rapidjson::Value{}.SetString(ex.what(), alloc), alloc);
-            }
+            // Error responses only carry the error, not the rest of the call
+            rapidjson::Document d{};
+            auto& alloc = d.GetAllocator();
+            d.SetObject();
+            d.AddMember("call_id", get_call_id(serial_obj), alloc);
+            d.AddMember("except_type", static_cast<int>(ex.get_type()), alloc);
+            d.AddMember("err_mesg", rapidjson::Value{}.SetString(ex.what(), alloc), alloc);
+            serial_obj = std::move(d);
         }
 
         template<typename T>
@@ -254,6 +434,114 @@ namespace adapters
         static T deserialize(const rapidjson::Value& serial_obj) = delete;
 
     private:
+        [[nodiscard]] static rapidjson::Document make_calls(const uint64_t call_id,
+            const char* const key, std::vector<rapidjson::Document>&& serial_objs)
+        {
+            rapidjson::Document d{};
+            auto& alloc = d.GetAllocator();
+            d.SetObject();
+            d.AddMember("call_id", call_id, alloc);
+
+            rapidjson::Value call_arr{};
+            call_arr.SetArray();
+            call_arr.Reserve(static_cast<rapidjson::SizeType>(serial_objs.size()), alloc);
+
+            for (const auto& serial_obj : serial_objs)
+            {
+                rapidjson::Value val{};
+                val.CopyFrom(serial_obj, alloc);
+                call_arr.PushBack(std::move(val), alloc);
+            }
+
+            d.AddMember(rapidjson::StringRef(key), std::move(call_arr), alloc);
+            return d;
+        }
+
+        [[nodiscard]] static std::vector<std::optional<rapidjson::Document>> split_calls(
+            const rapidjson::Document& serial_obj, const char* const key)
+        {
+            const auto& call_arr = serial_obj[key];
+            std::vector<std::optional<rapidjson::Document>> serial_objs{};
+            serial_objs.reserve(call_arr.Size());
+
+            for (const auto& val : call_arr.GetArray())
+            {
+                if (val.IsObject() && validate_object(val))
+                {
+                    rapidjson::Document d{};
+                    d.CopyFrom(val, d.GetAllocator());
+                    serial_objs.emplace_back(std::move(d));
+                }
+                else
+                {
+                    serial_objs.emplace_back(std::nullopt);
+                }
+            }
+
+            return serial_objs;
+        }
+
+        // nodiscard because this function is pointless without checking the bool
+        [[nodiscard]] static bool validate_object(const rapidjson::Value& obj)
+        {
+            if (const auto ex_it = obj.FindMember("except_type"); ex_it != obj.MemberEnd())
+            {
+                // Objects with exceptions can be otherwise empty
+                const auto& ex_val = ex_it->value;
+                return ex_val.IsInt() && (ex_val.GetInt() == 0 || obj.HasMember("err_mesg"));
+            }
+
+            // Responses and calls within a map are not named
+            if (obj.HasMember("func_name") && !validate_func_name(obj))
+            {
+                return false;
+            }
+
+            // Responses leave out the arguments when none are sent back
+            const auto args_it = obj.FindMember("args");
+            return args_it == obj.MemberEnd() || args_it->value.IsArray();
+        }
+
+        // nodiscard because this function is pointless without checking the bool
+        [[nodiscard]] static bool validate_func_name(const rapidjson::Value& obj)
+        {
+            const auto fname_it = obj.FindMember("func_name");
+            return fname_it != obj.MemberEnd() && fname_it->value.IsString()
+                && fname_it->value.GetStringLength() != 0;
+        }
+
+        [[nodiscard]] static const rapidjson::Value& get_args(const rapidjson::Value& serial_obj)
+        {
+            static const rapidjson::Value no_args{ rapidjson::kArrayType };
+            const auto args_it = serial_obj.FindMember("args");
+            return args_it != serial_obj.MemberEnd() ? args_it->value : no_args;
+        }
+
+        // Responses leave out the mask when no arguments are sent back
+        [[nodiscard]] static uint64_t get_arg_mask(const rapidjson::Value& serial_obj)
+        {
+            const auto mask_it = serial_obj.FindMember("arg_mask");
+
+            if (mask_it == serial_obj.MemberEnd())
+            {
+                return 0;
+            }
+
+            if (!mask_it->value.IsUint64())
+            {
+                throw deserialization_error("Invalid argument mask received");
+            }
+
+            return mask_it->value.GetUint64();
+        }
+
+        [[nodiscard]] static std::string read_func_name(const rapidjson::Value& serial_obj)
+        {
+            const auto fname_it = serial_obj.FindMember("func_name");
+            return fname_it != serial_obj.MemberEnd() ? fname_it->value.GetString()
+                                                      : std::string{};
+        }
+
         // nodiscard because this function is pointless without checking the bool
         template<typename T>
         [[nodiscard]] static constexpr bool validate_arg(const rapidjson::Value& arg) noexcept
@@ -377,6 +665,43 @@ namespace adapters
                 + ", got type: " + get_type_str() };
         }
 
+        template<typename R>
+        [[nodiscard]] static rapidjson::Value make_result(
+            const R& val, rapidjson::MemoryPoolAllocator<>& alloc)
+        {
+            rapidjson::Value result{};
+
+            if constexpr (std::is_arithmetic_v<R>)
+            {
+                result.Set<R>(val);
+            }
+            else if constexpr (std::is_same_v<R, std::string>)
+            {
+                result.SetString(val.c_str(), alloc);
+            }
+            else if constexpr (rpc_hpp::detail::is_container_v<R>)
+            {
+                result.SetArray();
+                result.Reserve(static_cast<rapidjson::SizeType>(val.size()), alloc);
+
+                for (const auto& elem : val)
+                {
+                    result.PushBack(elem, alloc);
+                }
+            }
+            else if constexpr (rpc_hpp::detail::is_serializable_v<rapidjson_adapter, R>)
+            {
+                const rapidjson::Document tmp = R::template serialize<rapidjson_adapter>(val);
+                result.CopyFrom(tmp, alloc);
+            }
+            else
+            {
+                result = serialize<R>(val, alloc);
+            }
+
+            return result;
+        }
+
         template<typename T>
         static void push_arg(
             T&& arg, rapidjson::Value& obj, rapidjson::MemoryPoolAllocator<>& alloc)
@@ -500,6 +825,43 @@ namespace adapters
             }
         }
 
+        // Strings and containers keep the storage out already holds
+        template<typename T>
+        static void parse_arg_into(const rapidjson::Value& arg, T& out)
+        {
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                if (!validate_arg<T>(arg))
+                {
+                    throw function_mismatch(mismatch_message(typeid(T).name(), arg));
+                }
+
+                out.assign(arg.GetString(), arg.GetStringLength());
+            }
+            else if constexpr (rpc_hpp::detail::is_container_v<T>)
+            {
+                using subvalue_t = typename T::value_type;
+
+                if (!validate_arg<T>(arg))
+                {
+                    throw function_mismatch(mismatch_message(typeid(T).name(), arg));
+                }
+
+                out.clear();
+                out.reserve(arg.Size());
+                unsigned arg_counter = 0;
+
+                for (const auto& val : arg.GetArray())
+                {
+                    out.push_back(parse_args<subvalue_t>(val, arg_counter));
+                }
+            }
+            else
+            {
+                out = parse_arg<T>(arg);
+            }
+        }
+
         // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
         template<typename T>
         [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_args(
@@ -519,6 +881,40 @@ namespace adapters
 
             return parse_arg<T>(arr[index++]);
         }
+
+        // nodiscard because parsing can be expensive, and it makes no sense to not use the parsed result
+        template<typename... Args>
+        [[nodiscard]] static std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...>
+            parse_call_args(
+                const rapidjson::Value& args_val, [[maybe_unused]] const uint64_t arg_mask)
+        {
+            [[maybe_unused]] size_t arg_index = 0;
+            [[maybe_unused]] unsigned arg_counter = 0;
+            std::tuple<std::remove_cv_t<std::remove_reference_t<Args>>...> args{
+                parse_masked_arg<Args>(args_val, arg_mask, arg_index, arg_counter)...
+            };
+
+            if (args_val.IsArray() && args_val.Size() > arg_counter)
+            {
+                throw function_mismatch("Argument count mismatch");
+            }
+
+            return args;
+        }
+
+        // Arguments left out of a response are default constructed (and never assigned back)
+        template<typename T>
+        [[nodiscard]] static std::remove_cv_t<std::remove_reference_t<T>> parse_masked_arg(
+            const rapidjson::Value& arg_arr, const uint64_t arg_mask, size_t& arg_index,
+            unsigned& index)
+        {
+            if (((arg_mask >> arg_index++) & 1U) == 0)
+            {
+                return {};
+            }
+
+            return parse_args<T>(arg_arr, index);
+        }
     };
 } // namespace adapters
 } // namespace rpc_hpp
@@ -38,10 +38,13 @@
 
 #include <asio.hpp>
 
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
 #if defined(RPC_HPP_ENABLE_BITSERY)
 #    include <rpc_adapters/rpc_bitsery.hpp>
-
-using rpc_hpp::adapters::bitsery_adapter;
 #endif
 
 #if defined(RPC_HPP_ENABLE_BOOST_JSON)
@@ -68,10 +71,28 @@ template<typename Serial>
 class TestClient final : public rpc_hpp::client_interface<Serial>
 {
 public:
+    using receive_handler_t =
+        std::function<void(typename Serial::bytes_t&&, const std::exception_ptr&)>;
+
     TestClient(const std::string_view host, const std::string_view port)
         : m_socket(m_io), m_resolver(m_io)
     {
         asio::connect(m_socket, m_resolver.resolve(host, port));
+
+        // Runs the asynchronous sends and receives
+        m_io_thread = std::thread([this] { m_io.run(); });
+    }
+
+    TestClient(const TestClient&) = delete;
+    TestClient(TestClient&&) = delete;
+    TestClient& operator=(const TestClient&) = delete;
+    TestClient& operator=(TestClient&&) = delete;
+
+    ~TestClient() noexcept override
+    {
+        m_work.reset();
+        m_io.stop();
+        m_io_thread.join();
     }
 
     // nodiscard because string is being allocated for return
@@ -80,58 +101,180 @@ public:
         return m_socket.remote_endpoint().address().to_string();
     }
 
+    // Holds back asynchronous receives until resumed, so that several calls can be seen
+    // outstanding at once
+    void pauseReceive()
+    {
+        asio::post(m_io, [this] { m_receive_paused = true; });
+    }
+
+    void resumeReceive()
+    {
+        asio::post(m_io,
+            [this]
+            {
+                m_receive_paused = false;
+
+                if (m_held_receive)
+                {
+                    startRead(std::exchange(m_held_receive, nullptr));
+                }
+            });
+    }
+
+    // Responses and call IDs the client is holding on to
+    [[nodiscard]] size_t heldResponses() const { return this->held_responses(); }
+
+    // Messages are framed by their length so that pipelined messages can be told apart
     void send(const typename Serial::bytes_t& mesg) override
     {
-        asio::write(m_socket, asio::buffer(mesg, mesg.size()));
+        // Calls may be made from several threads, and alongside asynchronous sends
+        std::lock_guard<std::mutex> lock{ m_write_mtx };
+
+        const auto len = static_cast<uint32_t>(mesg.size());
+
+        const std::array<asio::const_buffer, 2> buffers{ asio::buffer(&len, sizeof(len)),
+            asio::buffer(mesg.data(), mesg.size()) };
+
+        asio::write(m_socket, buffers);
+    }
+
+    // Written on the I/O thread, so the caller does not wait for the write
+    void async_send(typename Serial::bytes_t&& mesg,
+        std::function<void(const std::exception_ptr&)> on_sent) override
+    {
+        asio::post(m_io,
+            [this, mesg = std::move(mesg), on_sent = std::move(on_sent)]
+            {
+                try
+                {
+                    send(mesg);
+                }
+                catch (...)
+                {
+                    on_sent(std::current_exception());
+                    return;
+                }
+
+                on_sent(nullptr);
+            });
+    }
+
+    // Read on the I/O thread without blocking it, so outstanding calls do not hold a thread each
+    void async_receive(receive_handler_t on_received) override
+    {
+        asio::post(m_io,
+            [this, on_received = std::move(on_received)]() mutable
+            {
+                if (m_receive_paused)
+                {
+                    m_held_receive = std::move(on_received);
+                    return;
+                }
+
+                startRead(std::move(on_received));
+            });
     }
 
     // nodiscard because data is lost after receive
     [[nodiscard]] typename Serial::bytes_t receive() override
     {
-        const auto sz = m_socket.read_some(asio::buffer(m_buffer, m_buffer.size()));
-        return typename Serial::bytes_t{ m_buffer.begin(), m_buffer.begin() + sz };
+        uint32_t len = 0;
+        asio::read(m_socket, asio::buffer(&len, sizeof(len)));
+
+        typename Serial::bytes_t mesg(len, {});
+        asio::read(m_socket, asio::buffer(mesg.data(), mesg.size()));
+        return mesg;
     }
 
 private:
+    void startRead(receive_handler_t&& on_received)
+    {
+        asio::async_read(m_socket, asio::buffer(&m_read_len, sizeof(m_read_len)),
+            [this, on_received = std::move(on_received)](
+                const asio::error_code& error, size_t /*unused*/) mutable
+            {
+                if (error)
+                {
+                    on_received({}, std::make_exception_ptr(asio::system_error(error)));
+                    return;
+                }
+
+                m_read_mesg = typename Serial::bytes_t(m_read_len, {});
+
+                asio::async_read(m_socket, asio::buffer(m_read_mesg.data(), m_read_mesg.size()),
+                    [this, on_received = std::move(on_received)](
+                        const asio::error_code& body_error, size_t /*unused*/)
+                    {
+                        if (body_error)
+                        {
+                            on_received(
+                                {}, std::make_exception_ptr(asio::system_error(body_error)));
+                            return;
+                        }
+
+                        on_received(std::move(m_read_mesg), nullptr);
+                    });
+            });
+    }
+
     asio::io_context m_io{};
+    asio::executor_work_guard<asio::io_context::executor_type> m_work{ asio::make_work_guard(
+        m_io) };
+
     tcp::socket m_socket;
     tcp::resolver m_resolver;
-    std::array<uint8_t, 64UL * 1024UL> m_buffer{};
+    std::mutex m_write_mtx{};
+    std::thread m_io_thread{};
+
+    // Only used on the I/O thread, the client never has more than one receive in progress
+    uint32_t m_read_len{};
+    typename Serial::bytes_t m_read_mesg{};
+    bool m_receive_paused{ false };
+    receive_handler_t m_held_receive{};
 };
 
+// Port the test server listens on for each adapter
 template<typename Serial>
-TestClient<Serial>& GetClient();
+struct TestPort;
 
 template<>
-[[nodiscard]] inline TestClient<njson_adapter>& GetClient()
+struct TestPort<njson_adapter>
 {
-    static TestClient<njson_adapter> client("127.0.0.1", "5000");
-    return client;
-}
+    static constexpr const char* value = "5000";
+};
 
 #if defined(RPC_HPP_ENABLE_RAPIDJSON)
 template<>
-[[nodiscard]] inline TestClient<rapidjson_adapter>& GetClient()
+struct TestPort<rapidjson_adapter>
 {
-    static TestClient<rapidjson_adapter> client("127.0.0.1", "5001");
-    return client;
-}
+    static constexpr const char* value = "5001";
+};
 #endif
 
 #if defined(RPC_HPP_ENABLE_BOOST_JSON)
 template<>
-[[nodiscard]] inline TestClient<boost_json_adapter>& GetClient()
+struct TestPort<boost_json_adapter>
 {
-    static TestClient<boost_json_adapter> client("127.0.0.1", "5002");
-    return client;
-}
+    static constexpr const char* value = "5002";
+};
 #endif
 
 #if defined(RPC_HPP_ENABLE_BITSERY)
-template<>
-[[nodiscard]] inline TestClient<bitsery_adapter>& GetClient()
+// One server is run per encoding, clients may use their own limits
+template<typename Config>
+struct TestPort<rpc_hpp::adapters::basic_bitsery_adapter<Config>>
 {
-    static TestClient<bitsery_adapter> client("127.0.0.1", "5003");
+    static constexpr const char* value =
+        Config::encoding == rpc_hpp::adapters::bitsery_encoding::exact ? "5003"
+        : Config::encoding == rpc_hpp::adapters::bitsery_encoding::wide ? "5004"
+                                                                        : "5005";
+};
+#endif
+
+template<typename Serial>
+[[nodiscard]] TestClient<Serial>& GetClient()
+{
+    static TestClient<Serial> client("127.0.0.1", TestPort<Serial>::value);
     return client;
 }
-#endif
@@ -40,13 +40,27 @@
 #include "../test_structs.hpp"
 #include "../static_funcs.hpp"
 
+#include <chrono>
+#include <future>
+
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <doctest/doctest.h>
 
 #if defined(RPC_HPP_ENABLE_BITSERY)
-constexpr uint64_t bitsery_adapter::config::max_func_name_size = 30;
-constexpr uint64_t bitsery_adapter::config::max_string_size = 2048;
-constexpr uint64_t bitsery_adapter::config::max_container_size = 100;
+// The client accepts fewer container elements than the server, which uses the default limits
+template<rpc_hpp::adapters::bitsery_encoding Encoding>
+using test_bitsery_adapter = rpc_hpp::adapters::basic_bitsery_adapter<
+    rpc_hpp::adapters::bitsery_config<Encoding, 30, 2048, 100>>;
+
+using bitsery_exact_adapter = test_bitsery_adapter<rpc_hpp::adapters::bitsery_encoding::exact>;
+using bitsery_wide_adapter = test_bitsery_adapter<rpc_hpp::adapters::bitsery_encoding::wide>;
+using bitsery_compact_adapter =
+    test_bitsery_adapter<rpc_hpp::adapters::bitsery_encoding::compact>;
+
+// Each encoding has its own server, the one used for the remaining tests is picked with
+// RPC_HPP_BITSERY_EXACT_SZ or RPC_HPP_BITSERY_COMPACT_SZ
+using bitsery_adapter =
+    test_bitsery_adapter<rpc_hpp::adapters::bitsery_adapter::config::encoding>;
 #endif
 
 template<typename Serial>
@@ -82,7 +96,12 @@ TEST_CASE("BOOST_JSON")
 #if defined(RPC_HPP_ENABLE_BITSERY)
 TEST_CASE("BITSERY")
 {
-    TestType<bitsery_adapter>();
+    // Limits are part of the adapter's type, and can be used in constant expressions
+    static_assert(bitsery_adapter::config::max_container_size == 100);
+
+    TestType<bitsery_exact_adapter>();
+    TestType<bitsery_wide_adapter>();
+    TestType<bitsery_compact_adapter>();
 }
 #endif
 
@@ -168,6 +187,160 @@ TEST_CASE_TEMPLATE("StrLen", TestType, RPC_TEST_TYPES)
     REQUIRE(result2 == 5);
 }
 
+#if defined(RPC_HPP_ENABLE_BITSERY)
+TEST_CASE("StrLenView")
+{
+    auto& client = GetClient<bitsery_adapter>();
+    const std::string str = "std::string_view";
+
+    REQUIRE(client.call_func<size_t>("StrLenView", str) == str.size());
+    REQUIRE(client.call_func<size_t>("StrLenView", std::string_view{ str }) == str.size());
+
+    // Rejected before anything is sent, so the connection is still usable
+    const std::string long_str(bitsery_adapter::config::max_string_size + 1, 'x');
+    const auto exp = [&client, &long_str]
+    {
+        std::ignore = client.call_func<size_t>("StrLenView", std::string_view{ long_str });
+    };
+
+    REQUIRE_THROWS_AS(exp(), rpc_hpp::serialization_error);
+
+    REQUIRE(client.call_func<size_t>("StrLenView", std::string_view{ str }) == str.size());
+}
+
+TEST_CASE("SizeLimits")
+{
+    auto& client = GetClient<bitsery_adapter>();
+    const std::string long_str(bitsery_adapter::config::max_string_size + 1, 'x');
+    const std::vector<int> long_vec(bitsery_adapter::config::max_container_size + 1, 1);
+    const std::string long_name(bitsery_adapter::config::max_func_name_size + 1, 'f');
+
+    const auto long_string = [&client, &long_str]
+    {
+        std::ignore = client.call_func<size_t>("StrLen", long_str);
+    };
+
+    const auto long_container = [&client, &long_vec]
+    {
+        std::ignore = client.call_func<std::vector<int>>("AddOneToEach", long_vec);
+    };
+
+    const auto long_func_name = [&client, &long_name]
+    {
+        std::ignore = client.call_func<int>(long_name, 1, 2);
+    };
+
+    // Rejected before anything is sent, so the connection is still usable
+    REQUIRE_THROWS_AS(long_string(), rpc_hpp::serialization_error);
+    REQUIRE_THROWS_AS(long_container(), rpc_hpp::serialization_error);
+    REQUIRE_THROWS_AS(long_func_name(), rpc_hpp::serialization_error);
+    REQUIRE(client.call_func<int>("SimpleSum", 1, 2) == 3);
+}
+
+TEST_CASE("Aggregate")
+{
+    auto& client = GetClient<bitsery_adapter>();
+    const SensorReading reading{ 7, "mV", { 1.5, 2.5, 3.0, 4.0 }, { -1, 2 } };
+
+    const auto scaled = client.call_func<SensorReading>("ScaleReading", reading, 2.0);
+
+    REQUIRE(scaled.sensor_id == reading.sensor_id);
+    REQUIRE(scaled.unit == reading.unit);
+    REQUIRE(scaled.samples == std::array<double, 4>{ 3.0, 5.0, 6.0, 8.0 });
+    REQUIRE(scaled.flags == reading.flags);
+}
+
+TEST_CASE("Enum")
+{
+    auto& client = GetClient<bitsery_adapter>();
+    std::vector<SensorKind> seen{};
+
+    REQUIRE(client.call_func<SensorKind>("NextKind", SensorKind::voltage, seen)
+        == SensorKind::current);
+
+    REQUIRE(client.call_func<SensorKind>("NextKind", SensorKind::temperature, seen)
+        == SensorKind::voltage);
+
+    REQUIRE(seen == std::vector<SensorKind>{ SensorKind::voltage, SensorKind::temperature });
+}
+
+// Ten doubles are copied to and from the buffer as one block
+template<typename Serial>
+void TestFixedArgs()
+{
+    auto& client = GetClient<Serial>();
+
+    const auto avg = client.template call_func<double>("Average", 55.65, 125.325, 552.125,
+        12.767, 2599.6, 1245.125663, 9783.49, 125.12, 553.3333333333, 2266.1);
+
+    const auto std_dev = client.template call_func<double>("StdDev", 55.65, 125.325, 552.125,
+        12.767, 2599.6, 1245.125663, 9783.49, 125.12, 553.3333333333, 2266.1);
+
+    REQUIRE(avg == doctest::Approx(1731.8635996333));
+    REQUIRE(std_dev == doctest::Approx(3313.695594785));
+
+    // Every argument is sent back, so the response is a block as well
+    double n1 = 4.0;
+    double n2 = 9.0;
+    double n3 = 16.0;
+    double n4 = 25.0;
+    double n5 = 36.0;
+    double n6 = 49.0;
+    double n7 = 64.0;
+    double n8 = 81.0;
+    double n9 = 100.0;
+    double n10 = 121.0;
+
+    client.call_func("SquareRootRef", n1, n2, n3, n4, n5, n6, n7, n8, n9, n10);
+
+    REQUIRE(std::array<double, 10>{ n1, n2, n3, n4, n5, n6, n7, n8, n9, n10 }
+        == std::array<double, 10>{ 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0 });
+}
+
+TEST_CASE("FixedArgs")
+{
+    TestFixedArgs<bitsery_exact_adapter>();
+    TestFixedArgs<bitsery_wide_adapter>();
+    TestFixedArgs<bitsery_compact_adapter>();
+
+    // The block must hold exactly what bitsery writes for each value, which ends the request
+    const double n1 = 55.65;
+    const double n2 = 125.325;
+    std::vector<uint8_t> each_value{};
+    bitsery::Serializer<bitsery::OutputBufferAdapter<std::vector<uint8_t>>> ser{ each_value };
+    ser.value8b(n1);
+    ser.value8b(n2);
+    ser.adapter().flush();
+    each_value.resize(ser.adapter().writtenBytesCount());
+
+    const auto request = bitsery_adapter::serialize_request<double>(
+        rpc_hpp::detail::request_view<double, double>{ 0, "Average", { n1, n2 } });
+
+    REQUIRE(request.size() > each_value.size());
+    REQUIRE(std::equal(each_value.rbegin(), each_value.rend(), request.rbegin()));
+}
+
+TEST_CASE("StructMismatch")
+{
+    auto& client = GetClient<bitsery_adapter>();
+
+    const auto wrong_fields = [&client]
+    {
+        const FloatSensorReading reading{ 7, "mV", { 1.5F, 2.5F, 3.0F, 4.0F }, { -1, 2 } };
+        std::ignore = client.call_func<FloatSensorReading>("ScaleReading", reading, 2.0);
+    };
+
+    const auto wrong_object = [&client]
+    {
+        const WideComplexObject cx{ 24, "Franklin D. Roosevelt", false, true, {} };
+        std::ignore = client.call_func<std::string>("HashComplex", cx);
+    };
+
+    REQUIRE_THROWS_AS(wrong_fields(), rpc_hpp::function_mismatch);
+    REQUIRE_THROWS_AS(wrong_object(), rpc_hpp::function_mismatch);
+}
+#endif
+
 TEST_CASE_TEMPLATE("AddOneToEach", TestType, RPC_TEST_TYPES)
 {
     auto& client = GetClient<TestType>();
@@ -197,6 +370,19 @@ TEST_CASE_TEMPLATE("AddOneToEachRef", TestType, RPC_TEST_TYPES)
     }
 }
 
+TEST_CASE_TEMPLATE("CallFuncInto", TestType, RPC_TEST_TYPES)
+{
+    auto& client = GetClient<TestType>();
+    std::vector<int> result{};
+    result.reserve(16);
+    const auto* const storage = result.data();
+
+    client.call_func_into(result, "AddOneToEach", std::vector<int>{ 2, 4, 6, 8 });
+
+    REQUIRE(result == std::vector<int>{ 3, 5, 7, 9 });
+    REQUIRE(result.data() == storage);
+}
+
 TEST_CASE_TEMPLATE("Fibonacci", TestType, RPC_TEST_TYPES)
 {
     static constexpr uint64_t expected = 10946;
@@ -219,6 +405,302 @@ TEST_CASE_TEMPLATE("FibonacciRef", TestType, RPC_TEST_TYPES)
     REQUIRE(expected == test);
 }
 
+TEST_CASE_TEMPLATE("Prepared", TestType, RPC_TEST_TYPES)
+{
+    auto& client = GetClient<TestType>();
+
+    const auto fib = client.template prepare<uint64_t, uint64_t>("Fibonacci");
+    REQUIRE(fib.get_func_name() == "Fibonacci");
+    REQUIRE(fib(20) == 10946);
+    REQUIRE(fib(10) == 89);
+
+    const auto fib_ref = client.template prepare<void, uint64_t&>("FibonacciRef");
+    uint64_t test = 20;
+    fib_ref(test);
+    REQUIRE(test == 10946);
+
+    const auto str_len = client.template prepare<size_t, const std::string&>("StrLen");
+    REQUIRE(str_len("hello") == 5);
+}
+
+TEST_CASE_TEMPLATE("Pipelined", TestType, RPC_TEST_TYPES)
+{
+    static constexpr uint64_t expected = 10946;
+    static constexpr uint64_t input = 20;
+    auto& client = GetClient<TestType>();
+
+    uint64_t test = 20;
+    auto call1 = client.template call_func_pipelined<uint64_t>("Fibonacci", input);
+    auto call2 = client.call_func_pipelined("FibonacciRef", test);
+    auto call3 = client.template call_func_pipelined<int>("SimpleSum", 1, 2);
+
+    {
+        // Response should be dropped once it arrives
+        auto discarded = client.template call_func_pipelined<int>("SimpleSum", 3, 4);
+    }
+
+    REQUIRE(call1.get_call_id() != call2.get_call_id());
+
+    // Claim responses out of order
+    REQUIRE(call3.get() == 3);
+    call2.get();
+    REQUIRE(call1.get() == expected);
+    REQUIRE(test == expected);
+    REQUIRE(client.template call_func<int>("SimpleSum", 5, 6) == 11);
+}
+
+TEST_CASE_TEMPLATE("DiscardedResponses", TestType, RPC_TEST_TYPES)
+{
+    auto& client = GetClient<TestType>();
+
+    {
+        // Received while another call is claimed, then dropped
+        auto received = client.template call_func_pipelined<int>("SimpleSum", 1, 2);
+        REQUIRE(client.template call_func<int>("SimpleSum", 3, 4) == 7);
+    }
+
+    {
+        // Dropped before its response arrives
+        auto pending = client.template call_func_pipelined<int>("SimpleSum", 5, 6);
+    }
+
+    REQUIRE(client.template call_func<int>("SimpleSum", 7, 8) == 15);
+    REQUIRE(client.heldResponses() == 0);
+}
+
+TEST_CASE_TEMPLATE("UnattributedError", TestType, RPC_TEST_TYPES)
+{
+    typename TestType::bytes_t bytes{};
+    bytes.resize(8);
+
+    std::iota(bytes.begin(), bytes.end(), 0);
+
+    auto& client = GetClient<TestType>();
+
+    // The server cannot tell which call its error belongs to, so every outstanding call fails
+    client.send(std::move(bytes));
+    auto pending = client.template call_func_pipelined<int>("SimpleSum", 1, 2);
+
+    const auto exp = [&pending]
+    {
+        std::ignore = pending.get();
+    };
+
+    REQUIRE_THROWS_AS(exp(), rpc_hpp::server_receive_error);
+
+    // The late response to the failed call is dropped
+    REQUIRE(client.template call_func<int>("SimpleSum", 3, 4) == 7);
+    REQUIRE(client.heldResponses() == 0);
+}
+
+TEST_CASE_TEMPLATE("Async", TestType, RPC_TEST_TYPES)
+{
+    static constexpr uint64_t expected = 10946;
+    static constexpr uint64_t input = 20;
+    auto& client = GetClient<TestType>();
+
+    uint64_t test = 20;
+
+    // Nothing is read until resumed, so all the calls are outstanding before any is claimed
+    client.pauseReceive();
+    auto result1 = client.template call_func_async<uint64_t>("Fibonacci", input);
+    auto result2 = client.call_func_async("FibonacciRef", test);
+    auto result3 = client.call_func_async("ThrowError");
+
+    REQUIRE(result1.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+    REQUIRE(result2.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+    REQUIRE(result3.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+
+    client.resumeReceive();
+    REQUIRE(result1.get() == expected);
+    result2.get();
+    REQUIRE(test == expected);
+    REQUIRE_THROWS_AS(result3.get(), rpc_hpp::remote_exec_error);
+}
+
+TEST_CASE_TEMPLATE("ConcurrentCalls", TestType, RPC_TEST_TYPES)
+{
+    static constexpr int iterations = 50;
+    auto& client = GetClient<TestType>();
+
+    // Each thread waits in every way at once, so responses are often read by the other thread
+    const auto run_calls = [&client](const int offset)
+    {
+        bool success = true;
+
+        for (int i = 0; i < iterations; ++i)
+        {
+            auto pipelined = client.template call_func_pipelined<int>("SimpleSum", offset, i);
+            auto async = client.template call_func_async<int>("SimpleSum", i, offset * 2);
+
+            success = success && client.template call_func<int>("SimpleSum", i, i) == i * 2;
+            success = success && pipelined.get() == offset + i;
+            success = success && async.get() == i + offset * 2;
+        }
+
+        return success;
+    };
+
+    auto other = std::async(std::launch::async, run_calls, 1'000);
+    const bool success = run_calls(2'000);
+
+    REQUIRE(success);
+    REQUIRE(other.get());
+}
+
+TEST_CASE_TEMPLATE("Batch", TestType, RPC_TEST_TYPES)
+{
+    static constexpr uint64_t expected = 10946;
+    auto& client = GetClient<TestType>();
+
+    uint64_t test = 20;
+    auto [sum, fib, missing, error] =
+        client.call_batch(rpc_hpp::batch_call<int>("SimpleSum", 1, 2),
+            rpc_hpp::batch_call("FibonacciRef", test), rpc_hpp::batch_call<int>("MissingFunc", 3),
+            rpc_hpp::batch_call("ThrowError"));
+
+    REQUIRE(sum.get() == 3);
+    REQUIRE(static_cast<bool>(fib));
+    REQUIRE(test == expected);
+    REQUIRE_THROWS_AS(missing.get(), rpc_hpp::function_not_found);
+    REQUIRE_THROWS_AS(error.get(), rpc_hpp::remote_exec_error);
+
+    std::vector<rpc_hpp::batched_call<int, int, int>> calls{};
+
+    for (int i = 0; i < 10; ++i)
+    {
+        calls.push_back(rpc_hpp::batch_call<int>("SimpleSum", i * 2, 10));
+    }
+
+    const auto results = client.call_batch(std::move(calls));
+    REQUIRE(results.size() == 10);
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        REQUIRE(results[i].get() == static_cast<int>(i) * 2 + 10);
+    }
+}
+
+TEST_CASE_TEMPLATE("Notify", TestType, RPC_TEST_TYPES)
+{
+    auto& client = GetClient<TestType>();
+
+    // One-way calls are never answered, even on error, so the next call gets its own response
+    client.template notify<int>("SimpleSum", 1, 2);
+    client.notify("MissingFunc");
+    client.notify("ThrowError");
+
+    REQUIRE(client.template call_func<int>("SimpleSum", 3, 4) == 7);
+}
+
+TEST_CASE_TEMPLATE("Map", TestType, RPC_TEST_TYPES)
+{
+    static constexpr uint64_t expected[] = { 1, 2, 3, 5, 8, 13, 21, 34, 55, 89 };
+    auto& client = GetClient<TestType>();
+
+    std::vector<std::tuple<uint64_t>> arg_sets{};
+
+    for (uint64_t i = 1; i <= 10; ++i)
+    {
+        arg_sets.emplace_back(i);
+    }
+
+    const auto results = client.template call_map<uint64_t>("Fibonacci", arg_sets);
+    REQUIRE(results.size() == arg_sets.size());
+
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        REQUIRE(results[i].get() == expected[i]);
+    }
+
+    const auto sums = client.template call_map<int>(
+        "SimpleSum", std::vector<std::tuple<int, int>>{ { 1, 2 }, { 3, 4 } });
+
+    REQUIRE(sums.size() == 2);
+    REQUIRE(sums[0].get() == 3);
+    REQUIRE(sums[1].get() == 7);
+
+    // Enough calls to be split between the server's workers
+    std::vector<std::tuple<int, int>> many_args{};
+
+    for (int i = 0; i < 100; ++i)
+    {
+        many_args.emplace_back(i, i);
+    }
+
+    const auto many_sums = client.template call_map<int>("SimpleSum", many_args);
+    REQUIRE(many_sums.size() == many_args.size());
+
+    for (size_t i = 0; i < many_sums.size(); ++i)
+    {
+        REQUIRE(many_sums[i].get() == static_cast<int>(i) * 2);
+    }
+
+    const auto missing =
+        client.template call_map<int>("MissingFunc", std::vector<std::tuple<int>>{ 1, 2 });
+
+    REQUIRE(missing.size() == 2);
+    REQUIRE_THROWS_AS(missing[0].get(), rpc_hpp::function_not_found);
+    REQUIRE_THROWS_AS(missing[1].get(), rpc_hpp::function_not_found);
+
+    REQUIRE(client.template call_map<int>("SimpleSum", std::vector<std::tuple<int, int>>{})
+                .empty());
+}
+
+TEST_CASE_TEMPLATE("Chain", TestType, RPC_TEST_TYPES)
+{
+    static constexpr uint64_t num = 10;
+    static constexpr double expected = 89.0;
+    auto& client = GetClient<TestType>();
+
+    const auto average = client.call_chain(
+        rpc_hpp::chain_call<std::vector<uint64_t>>("GenRandInts", num, num, size_t{ 5 }),
+        rpc_hpp::chain_map<uint64_t>("Fibonacci", rpc_hpp::chain_ref<0>{}),
+        rpc_hpp::chain_call<double>("AverageContainer<uint64_t>", rpc_hpp::chain_ref<1>{}));
+
+    REQUIRE(average == expected);
+
+    const auto vec = client.call_chain(
+        rpc_hpp::chain_call<std::vector<int>>("AddOneToEach", std::vector<int>{ 1, 2, 3 }),
+        rpc_hpp::chain_call<std::vector<int>>("AddOneToEach", rpc_hpp::chain_ref<0>{}));
+
+    REQUIRE(vec == std::vector<int>{ 3, 4, 5 });
+
+    REQUIRE_THROWS_AS(static_cast<void>(client.call_chain(
+                          rpc_hpp::chain_call<int>("SimpleSum", 1, 2),
+                          rpc_hpp::chain_call<int>("MissingFunc", rpc_hpp::chain_ref<0>{}))),
+        rpc_hpp::function_not_found);
+
+    REQUIRE_THROWS_AS(static_cast<void>(client.call_chain(
+                          rpc_hpp::chain_call<std::vector<int>>("AddOneToEach", std::vector<int>{}),
+                          rpc_hpp::chain_call<double>(
+                              "AverageContainer<uint64_t>", rpc_hpp::chain_ref<0>{}))),
+        rpc_hpp::function_mismatch);
+}
+
+#if defined(RPC_HPP_HAS_COROUTINES)
+template<typename Serial>
+rpc_hpp::task<uint64_t> FibonacciChain(TestClient<Serial>& client, uint64_t number)
+{
+    co_await client.call_func_co("FibonacciRef", number);
+    co_return co_await client.template call_func_co<uint64_t>("FibonacciCo", number % 20);
+}
+
+TEST_CASE_TEMPLATE("Coroutine", TestType, RPC_TEST_TYPES)
+{
+    static constexpr uint64_t expected = 10946;
+    auto& client = GetClient<TestType>();
+
+    REQUIRE(rpc_hpp::sync_wait(FibonacciChain(client, 20)) == 13);
+
+    const auto error_check = [](TestClient<TestType>& cl) -> rpc_hpp::task<void>
+    { co_await cl.call_func_co("ThrowError"); };
+
+    REQUIRE_THROWS_AS(rpc_hpp::sync_wait(error_check(client)), rpc_hpp::remote_exec_error);
+    REQUIRE(client.template call_func<uint64_t>("FibonacciCo", uint64_t{ 20 }) == expected);
+}
+#endif
+
 TEST_CASE_TEMPLATE("StdDev", TestType, RPC_TEST_TYPES)
 {
     static constexpr double expected = 3313.695594785;
@@ -264,6 +746,22 @@ TEST_CASE_TEMPLATE("AverageContainer<double>", TestType, RPC_TEST_TYPES)
     const auto test = client.template call_func<double>("AverageContainer<double>", vec);
 
     REQUIRE(test == doctest::Approx(expected).epsilon(0.001));
+
+    // The vector is taken by value, so it is not sent back with the result
+    const std::string func_name = "AverageContainer<double>";
+    const rpc_hpp::detail::request_view<std::vector<double>> request{ 0, func_name, { vec } };
+
+    client.send(TestType::to_bytes(TestType::template serialize_request<double>(request)));
+    const auto serial_obj = TestType::from_bytes(client.receive());
+
+    REQUIRE(serial_obj.has_value());
+
+    const auto response =
+        TestType::template deserialize_response<double, std::vector<double>>(serial_obj.value());
+
+    REQUIRE(response.get_arg_mask() == 0);
+    REQUIRE(std::get<0>(response.get_args()).empty());
+    REQUIRE(response.get_result() == doctest::Approx(expected).epsilon(0.001));
 }
 
 TEST_CASE_TEMPLATE("HashComplex", TestType, RPC_TEST_TYPES)
@@ -362,18 +860,27 @@ TEST_CASE_TEMPLATE("ThrowError", TestType, RPC_TEST_TYPES)
     };
 
     REQUIRE_THROWS_AS(exp(), rpc_hpp::remote_exec_error);
+
+    // The error response only carries the call ID and the error
+    const std::string func_name = "ThrowError";
+    const rpc_hpp::detail::request_view<> request{ 42, func_name, {} };
+
+    client.send(TestType::to_bytes(TestType::template serialize_request<void>(request)));
+    const auto serial_obj = TestType::from_bytes(client.receive());
+
+    REQUIRE(serial_obj.has_value());
+    REQUIRE(TestType::get_call_id(serial_obj.value()) == 42);
+    REQUIRE(TestType::extract_exception(serial_obj.value()).get_type()
+        == rpc_hpp::exception_type::remote_exec);
+
+    const auto response = TestType::template deserialize_response<void>(serial_obj.value());
+
+    REQUIRE(!response);
+    REQUIRE(response.get_func_name().empty());
 }
 
 TEST_CASE_TEMPLATE("InvalidObject", TestType, RPC_TEST_TYPES)
 {
-#if defined(RPC_HPP_ENABLE_BITSERY)
-    if (std::is_same_v<TestType, bitsery_adapter>)
-    {
-        // TODO: Verify bitsery data somehow
-        return;
-    }
-#endif
-
     typename TestType::bytes_t bytes{};
     bytes.resize(8);
 
@@ -398,14 +905,7 @@ TEST_CASE("KillServer")
         std::ignore = client.template call_func<int>("SimpleSum", 1, 2);
     };
 
-    try
-    {
-        client.call_func("KillServer");
-    }
-    catch (...)
-    {
-        // Exception is expected so continue
-    }
+    client.notify("KillServer");
 
     REQUIRE_THROWS_AS(exp(), rpc_hpp::client_receive_error);
 }
@@ -61,16 +61,19 @@ using rpc_hpp::adapters::boost_json_adapter;
 #if defined(RPC_HPP_ENABLE_BITSERY)
 #    include <rpc_adapters/rpc_bitsery.hpp>
 
-using rpc_hpp::adapters::bitsery_adapter;
-
-constexpr uint64_t bitsery_adapter::config::max_func_name_size = 30;
-constexpr uint64_t bitsery_adapter::config::max_string_size = 2048;
-constexpr uint64_t bitsery_adapter::config::max_container_size = 1'000;
+// Every encoding is served on its own port, with the default limits
+using bitsery_exact_adapter = rpc_hpp::adapters::basic_bitsery_adapter<
+    rpc_hpp::adapters::bitsery_config<rpc_hpp::adapters::bitsery_encoding::exact>>;
+using bitsery_wide_adapter = rpc_hpp::adapters::basic_bitsery_adapter<
+    rpc_hpp::adapters::bitsery_config<rpc_hpp::adapters::bitsery_encoding::wide>>;
+using bitsery_compact_adapter = rpc_hpp::adapters::basic_bitsery_adapter<
+    rpc_hpp::adapters::bitsery_config<rpc_hpp::adapters::bitsery_encoding::compact>>;
 #endif
 
 #include <algorithm>
 #include <cmath>
 #include <sstream>
+#include <string_view>
 #include <thread>
 
 #if defined(RPC_HPP_ENABLE_SERVER_CACHE)
@@ -124,6 +127,32 @@ int CountChars(const std::string& str, char c)
         std::count_if(str.begin(), str.end(), [c](const char x) { return x == c; }));
 }
 
+#if defined(RPC_HPP_ENABLE_BITSERY)
+// Reads the string straight from the request (bitsery only)
+size_t StrLenView(std::string_view str)
+{
+    return str.size();
+}
+
+// Takes and returns an aggregate without a serialize function (bitsery only)
+SensorReading ScaleReading(SensorReading reading, const double factor)
+{
+    for (auto& sample : reading.samples)
+    {
+        sample *= factor;
+    }
+
+    return reading;
+}
+
+// Takes and returns an enum, and a container of them (bitsery only)
+SensorKind NextKind(const SensorKind kind, std::vector<SensorKind>& seen)
+{
+    seen.push_back(kind);
+    return static_cast<SensorKind>((static_cast<int>(kind) + 1) % 3);
+}
+#endif
+
 void AddOne(size_t& n)
 {
     n += 1;
@@ -145,6 +174,20 @@ void FibonacciRef(uint64_t& number)
     }
 }
 
+#if defined(RPC_HPP_HAS_COROUTINES)
+rpc_hpp::task<uint64_t> FibonacciCo(const uint64_t number)
+{
+    if (number < 2)
+    {
+        co_return 1;
+    }
+
+    const auto n1 = co_await FibonacciCo(number - 1);
+    const auto n2 = co_await FibonacciCo(number - 2);
+    co_return n1 + n2;
+}
+#endif
+
 // cached
 double StdDev(const double n1, const double n2, const double n3, const double n4, const double n5,
     const double n6, const double n7, const double n8, const double n9, const double n10)
@@ -221,6 +264,14 @@ void HashComplexRef(ComplexObject& cx, std::string& hashStr)
     hashStr = hash.str();
 }
 
+#if defined(RPC_HPP_ENABLE_BITSERY)
+template<typename Serial>
+inline constexpr bool is_bitsery_v = false;
+
+template<typename Config>
+inline constexpr bool is_bitsery_v<rpc_hpp::adapters::basic_bitsery_adapter<Config>> = true;
+#endif
+
 template<typename Serial>
 void BindFuncs(TestServer<Serial>& server)
 {
@@ -233,6 +284,19 @@ void BindFuncs(TestServer<Serial>& server)
     server.bind("HashComplexRef", &HashComplexRef);
     server.template bind<void, size_t&>("AddOne", [](size_t& n) { AddOne(n); });
 
+#if defined(RPC_HPP_ENABLE_BITSERY)
+    if constexpr (is_bitsery_v<Serial>)
+    {
+        server.bind("StrLenView", &StrLenView);
+        server.bind("ScaleReading", &ScaleReading);
+        server.bind("NextKind", &NextKind);
+    }
+#endif
+
+#if defined(RPC_HPP_HAS_COROUTINES)
+    server.bind_coroutine("FibonacciCo", &FibonacciCo);
+#endif
+
     server.bind_cached("SimpleSum", &SimpleSum);
     server.bind_cached("StrLen", &StrLen);
     server.bind_cached("AddOneToEach", &AddOneToEach);
@@ -416,10 +480,20 @@ int main(const int argc, char* argv[])
 #endif
 
 #if defined(RPC_HPP_ENABLE_BITSERY)
-        TestServer<bitsery_adapter> bitsery_server{ io_context, 5003U };
-        BindFuncs(bitsery_server);
-        threads.emplace_back(&TestServer<bitsery_adapter>::Run, &bitsery_server);
-        puts("Running Bitsery server on port 5003...");
+        TestServer<bitsery_exact_adapter> bitsery_exact_server{ io_context, 5003U };
+        BindFuncs(bitsery_exact_server);
+        threads.emplace_back(&TestServer<bitsery_exact_adapter>::Run, &bitsery_exact_server);
+        puts("Running Bitsery (exact) server on port 5003...");
+
+        TestServer<bitsery_wide_adapter> bitsery_wide_server{ io_context, 5004U };
+        BindFuncs(bitsery_wide_server);
+        threads.emplace_back(&TestServer<bitsery_wide_adapter>::Run, &bitsery_wide_server);
+        puts("Running Bitsery (wide) server on port 5004...");
+
+        TestServer<bitsery_compact_adapter> bitsery_compact_server{ io_context, 5005U };
+        BindFuncs(bitsery_compact_server);
+        threads.emplace_back(&TestServer<bitsery_compact_adapter>::Run, &bitsery_compact_server);
+        puts("Running Bitsery (compact) server on port 5005...");
 #endif
 
         for (auto& th : threads)
@@ -77,6 +77,10 @@ constexpr uint64_t Fibonacci(const uint64_t number)
 
 void FibonacciRef(uint64_t& number);
 
+#if defined(RPC_HPP_HAS_COROUTINES)
+rpc_hpp::task<uint64_t> FibonacciCo(uint64_t number);
+#endif
+
 // cached
 constexpr double Average(const double n1, const double n2, const double n3, const double n4,
     const double n5, const double n6, const double n7, const double n8, const double n9,
@@ -110,13 +114,13 @@ public:
     TestServer(asio::io_context& io, const uint16_t port)
         : m_accept(io, tcp::endpoint(tcp::v4(), port))
     {
+        // Calls in a batch are run concurrently
+        this->set_worker_count(4);
     }
 
+    // Messages are framed by their length so that pipelined requests can be told apart
     void Run()
     {
-        static constexpr auto BUFFER_SZ = 64U * 1024UL;
-        std::array<uint8_t, BUFFER_SZ> data{};
-
         while (RUNNING)
         {
             tcp::socket sock = m_accept.accept();
@@ -125,8 +129,9 @@ public:
             {
                 while (RUNNING)
                 {
+                    uint32_t len = 0;
                     asio::error_code error;
-                    const size_t len = sock.read_some(asio::buffer(data.data(), BUFFER_SZ), error);
+                    asio::read(sock, asio::buffer(&len, sizeof(len)), error);
 
                     if (error == asio::error::eof)
                     {
@@ -139,8 +144,15 @@ public:
                         throw asio::system_error(error);
                     }
 
-                    const auto bytes = this->dispatch({ std::begin(data), std::begin(data) + len });
-                    write(sock, asio::buffer(bytes, bytes.size()));
+                    typename Serial::bytes_t data(len, {});
+                    asio::read(sock, asio::buffer(data.data(), data.size()));
+
+#if defined(RPC_HPP_HAS_COROUTINES)
+                    this->dispatch_async(std::move(data),
+                        [&sock](typename Serial::bytes_t&& bytes) { Respond(sock, bytes); });
+#else
+                    Respond(sock, this->dispatch(std::move(data)));
+#endif
                 }
             }
             catch (const std::exception& ex)
@@ -151,5 +163,22 @@ public:
     }
 
 private:
+    static void Respond(tcp::socket& sock, const typename Serial::bytes_t& bytes)
+    {
+        // One-way calls are not answered
+        if (bytes.empty())
+        {
+            return;
+        }
+
+        const auto out_len = static_cast<uint32_t>(bytes.size());
+
+        const std::array<asio::const_buffer, 2> buffers{
+            asio::buffer(&out_len, sizeof(out_len)), asio::buffer(bytes.data(), bytes.size())
+        };
+
+        write(sock, buffers);
+    }
+
     tcp::acceptor m_accept;
 };
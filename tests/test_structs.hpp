@@ -38,8 +38,6 @@
 
 #if defined(RPC_HPP_ENABLE_BITSERY)
 #    include <rpc_adapters/rpc_bitsery.hpp>
-
-using rpc_hpp::adapters::bitsery_adapter;
 #endif
 
 #if defined(RPC_HPP_ENABLE_BOOST_JSON)
@@ -68,6 +66,7 @@ using rpc_hpp::adapters::rapidjson_adapter;
 #include <array>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 struct ComplexObject
 {
@@ -92,6 +91,52 @@ void serialize(S& s, ComplexObject& val)
     s.value1b(val.flag2);
     s.container1b(val.vals);
 }
+
+// Written field by field by the bitsery adapter, which needs no serialize function for aggregates
+struct SensorReading
+{
+    uint32_t sensor_id{};
+    std::string unit{};
+    std::array<double, 4> samples{};
+    std::vector<int16_t> flags{};
+};
+
+// Written as its underlying integer by the bitsery adapter
+enum class SensorKind : uint8_t
+{
+    voltage,
+    current,
+    temperature,
+};
+
+// Same number of fields as SensorReading, but its samples have a different type
+struct FloatSensorReading
+{
+    uint32_t sensor_id{};
+    std::string unit{};
+    std::array<float, 4> samples{};
+    std::vector<int16_t> flags{};
+};
+
+// Same number of fields as ComplexObject, but with more values
+struct WideComplexObject
+{
+    int id{};
+    std::string name{};
+    bool flag1{};
+    bool flag2{};
+    std::array<uint8_t, 16> vals{};
+};
+
+template<typename S>
+void serialize(S& s, WideComplexObject& val)
+{
+    s.value4b(val.id);
+    s.text1b(val.name, 255);
+    s.value1b(val.flag1);
+    s.value1b(val.flag2);
+    s.container1b(val.vals);
+}
 #endif
 
 #if defined(RPC_HPP_ENABLE_BOOST_JSON)